@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+//     
+inline int PopCount(uint64_t word) noexcept {
+#if defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<int>(__popcnt64(word));
+#elif defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<int>((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+//    .     
+inline int CountTrailingZeros(uint64_t word) noexcept {
+    assert(word != 0);
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index = 0;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#elif defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int index = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
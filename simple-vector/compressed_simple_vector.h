@@ -0,0 +1,386 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "simple_vector.h"
+
+//   CompressedSimpleVector.      , 
+//    65    ,      
+class DeltaBlockDecoder {
+public:
+    static constexpr size_t kBlockSize = 128;
+
+    static uint64_t UnZigZag(uint64_t value) noexcept {
+        return (value >> 1) ^ (0 - (value & 1));
+    }
+
+    //  kBlockSize      first  
+    //  width,     words.     ,
+    //     
+    static void Decode(const uint64_t* words, unsigned width, uint64_t first, uint64_t* out) noexcept {
+        GetUnpackTable()[width](words, first, out);
+    }
+
+private:
+    using UnpackFunction = void (*)(const uint64_t* words, uint64_t first, uint64_t* out);
+
+    static constexpr size_t Gcd(size_t lhs, size_t rhs) noexcept {
+        return rhs == 0 ? lhs : Gcd(rhs, lhs % rhs);
+    }
+
+    template <unsigned Width, size_t Index>
+    static void UnpackDelta(const uint64_t* words, uint64_t* deltas) noexcept {
+        constexpr uint64_t mask = Width == 64 ? ~uint64_t(0) : (uint64_t(1) << Width) - 1;
+        constexpr size_t bit = Index * Width;
+        constexpr size_t offset = bit % 64;
+        uint64_t delta = words[bit / 64] >> offset;
+        if constexpr (offset + Width > 64) {
+            delta |= words[bit / 64 + 1] << (64 - offset);
+        }
+        deltas[Index] = delta & mask;
+    }
+
+    template <unsigned Width, size_t... Indices>
+    static void UnpackGroup(const uint64_t* words, uint64_t* deltas, std::index_sequence<Indices...>) noexcept {
+        (UnpackDelta<Width, Indices>(words, deltas), ...);
+    }
+
+    //       kBlockSize - 1   Width.
+    //  group_words    group_size ,   
+    //   ,          
+    //  .    ,     
+    template <unsigned Width>
+    static void UnpackDeltas(const uint64_t* words, uint64_t first, uint64_t* out) noexcept {
+        out[0] = first;
+        if constexpr (Width == 0) {
+            std::fill(out + 1, out + kBlockSize, first);
+        }
+        else {
+            constexpr size_t group_size = 64 / Gcd(Width, 64);
+            constexpr size_t group_words = Width / Gcd(Width, 64);
+            uint64_t deltas[group_size];
+            uint64_t value = first;
+            for (size_t i = 0; i < kBlockSize - 1; i += group_size, words += group_words) {
+                UnpackGroup<Width>(words, deltas, std::make_index_sequence<group_size>());
+                size_t count = std::min(group_size, kBlockSize - 1 - i);
+                for (size_t j = 0; j < count; ++j) {
+                    value += UnZigZag(deltas[j]);
+                    out[i + j + 1] = value;
+                }
+            }
+        }
+    }
+
+    template <size_t... Widths>
+    static constexpr std::array<UnpackFunction, sizeof...(Widths)> MakeUnpackTable(std::index_sequence<Widths...>) {
+        return { &UnpackDeltas<static_cast<unsigned>(Widths)>... };
+    }
+
+    static const std::array<UnpackFunction, 65>& GetUnpackTable() {
+        static constexpr std::array<UnpackFunction, 65> table = MakeUnpackTable(std::make_index_sequence<65>());
+        return table;
+    }
+};
+
+//    ,     .
+//      kBlockSize.      ,
+//     -  zigzag-,      .
+//    (, )   -
+//   .    ,       O(1).
+//     ,   
+template <typename Type = uint64_t>
+class CompressedSimpleVector {
+    static_assert(std::is_integral_v<Type> && !std::is_same_v<Type, bool>,
+        "CompressedSimpleVector stores integers only");
+
+public:
+    static constexpr size_t kBlockSize = DeltaBlockDecoder::kBlockSize;
+
+    class ConstIterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Type*;
+        using reference = const Type&;
+
+        ConstIterator() = default;
+
+        //             
+        ConstIterator(const CompressedSimpleVector* vector, size_t index) : vector_(vector), index_(index) {
+            if (index_ < vector_->GetSize()) {
+                vector_->LoadBlock(index_ / kBlockSize, buffer_.data());
+            }
+        }
+
+        reference operator*() const noexcept {
+            return buffer_[index_ % kBlockSize];
+        }
+
+        pointer operator->() const noexcept {
+            return &buffer_[index_ % kBlockSize];
+        }
+
+        ConstIterator& operator++() {
+            ++index_;
+            if (index_ % kBlockSize == 0 && index_ < vector_->GetSize()) {
+                vector_->LoadBlock(index_ / kBlockSize, buffer_.data());
+            }
+            return *this;
+        }
+
+        //        ,  
+        //    ,   : *it++  
+        class PostIncrementProxy {
+        public:
+            explicit PostIncrementProxy(Type value) noexcept : value_(value) {
+            }
+
+            Type operator*() const noexcept {
+                return value_;
+            }
+
+        private:
+            Type value_;
+        };
+
+        PostIncrementProxy operator++(int) {
+            PostIncrementProxy previous(**this);
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const ConstIterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const ConstIterator& other) const noexcept {
+            return index_ != other.index_;
+        }
+
+    private:
+        const CompressedSimpleVector* vector_ = nullptr;
+        size_t index_ = 0;
+        std::array<Type, kBlockSize> buffer_;  //    LoadBlock,  
+    };
+
+    CompressedSimpleVector() = default;
+
+    //    .     ,
+    //        
+    explicit CompressedSimpleVector(const SimpleVector<Type>& values) {
+        size_t blocks = values.GetSize() / kBlockSize;
+        size_t words = 0;
+        for (size_t i = 0; i < blocks; ++i) {
+            words += WordsFor(BlockWidth(values.begin() + i * kBlockSize));
+        }
+        data_.Reserve(words);
+        blocks_.Reserve(blocks);
+        for (const Type& value : values) {
+            PushBack(value);
+        }
+    }
+
+    CompressedSimpleVector(std::initializer_list<Type> init) {
+        for (const Type& value : init) {
+            PushBack(value);
+        }
+    }
+
+    size_t GetSize() const noexcept {
+        return blocks_.GetSize() * kBlockSize + tail_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    //  ,   ,     
+    size_t GetMemoryUsage() const noexcept {
+        return data_.GetCapacity() * sizeof(uint64_t)
+            + blocks_.GetCapacity() * sizeof(BlockHeader)
+            + tail_.GetCapacity() * sizeof(Type);
+    }
+
+    void Clear() noexcept {
+        data_.Clear();
+        blocks_.Clear();
+        tail_.Clear();
+    }
+
+    //    .       
+    void PushBack(Type value) {
+        if (tail_.GetCapacity() < kBlockSize) {
+            tail_.Reserve(kBlockSize);
+        }
+        tail_.PushBack(value);
+        if (tail_.GetSize() == kBlockSize) {
+            SealBlock();
+        }
+    }
+
+    //     index.     ,
+    //      kBlockSize - 1 
+    Type operator[](size_t index) const noexcept {
+        assert(index < GetSize());
+        size_t block_index = index / kBlockSize;
+        size_t position = index % kBlockSize;
+        if (block_index == blocks_.GetSize()) {
+            return tail_[position];
+        }
+        const BlockHeader& header = blocks_[block_index];
+        const uint64_t* words = data_.begin() + header.offset;
+        uint64_t value = static_cast<uint64_t>(header.first);
+        for (size_t i = 0; i < position; ++i) {
+            value += DeltaBlockDecoder::UnZigZag(LoadBits(words, i * header.width, header.width));
+        }
+        return static_cast<Type>(value);
+    }
+
+    //   std::out_of_range,  index >= size
+    Type At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("index >= size");
+        }
+        return (*this)[index];
+    }
+
+    //      
+    SimpleVector<Type> Decompress() const {
+        SimpleVector<Type> result(GetSize());
+        for (size_t i = 0; i < blocks_.GetSize(); ++i) {
+            DecodeBlock(i, result.begin() + i * kBlockSize);
+        }
+        std::copy(tail_.begin(), tail_.end(), result.begin() + blocks_.GetSize() * kBlockSize);
+        return result;
+    }
+
+    ConstIterator begin() const {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const {
+        return ConstIterator(this, GetSize());
+    }
+
+    ConstIterator cbegin() const {
+        return begin();
+    }
+
+    ConstIterator cend() const {
+        return end();
+    }
+
+private:
+    struct BlockHeader {
+        Type first = 0;      //   
+        size_t offset = 0;   //    data_,     
+        uint8_t width = 0;   //     
+    };
+
+    SimpleVector<uint64_t> data_;
+    SimpleVector<BlockHeader> blocks_;
+    SimpleVector<Type> tail_;
+
+    static uint64_t ZigZag(uint64_t delta) noexcept {
+        return (delta << 1) ^ (0 - (delta >> 63));
+    }
+
+    static uint64_t LoadBits(const uint64_t* words, size_t bit, unsigned width) noexcept {
+        if (width == 0) {
+            return 0;
+        }
+        size_t word_index = bit / 64;
+        size_t offset = bit % 64;
+        uint64_t value = words[word_index] >> offset;
+        if (offset + width > 64) {
+            value |= words[word_index + 1] << (64 - offset);
+        }
+        return width == 64 ? value : value & ((uint64_t(1) << width) - 1);
+    }
+
+    void DecodeBlock(size_t block_index, Type* out) const {
+        const BlockHeader& header = blocks_[block_index];
+        const uint64_t* words = data_.begin() + header.offset;
+        if constexpr (std::is_same_v<Type, uint64_t>) {
+            DeltaBlockDecoder::Decode(words, header.width, header.first, out);
+        }
+        else {
+            uint64_t values[kBlockSize];
+            DeltaBlockDecoder::Decode(words, header.width, static_cast<uint64_t>(header.first), values);
+            for (size_t i = 0; i < kBlockSize; ++i) {
+                out[i] = static_cast<Type>(values[i]);
+            }
+        }
+    }
+
+    //   out    block_index,     
+    void LoadBlock(size_t block_index, Type* out) const {
+        if (block_index < blocks_.GetSize()) {
+            DecodeBlock(block_index, out);
+        }
+        else {
+            std::copy(tail_.begin(), tail_.end(), out);
+        }
+    }
+
+    static uint64_t Delta(const Type* values, size_t i) noexcept {
+        return ZigZag(static_cast<uint64_t>(values[i + 1]) - static_cast<uint64_t>(values[i]));
+    }
+
+    //     kBlockSize ,   values
+    static unsigned BlockWidth(const Type* values) noexcept {
+        uint64_t all_bits = 0;
+        for (size_t i = 0; i + 1 < kBlockSize; ++i) {
+            all_bits |= Delta(values, i);
+        }
+        unsigned width = 0;
+        while (width < 64 && (all_bits >> width) != 0) {
+            ++width;
+        }
+        return width;
+    }
+
+    //       width.    kBlockSize ,
+    //   kBlockSize - 1:          
+    static size_t WordsFor(unsigned width) noexcept {
+        return (kBlockSize * width + 63) / 64;
+    }
+
+    //      
+    void SealBlock() {
+        unsigned width = BlockWidth(tail_.begin());
+
+        BlockHeader header;
+        header.first = tail_[0];
+        header.offset = data_.GetSize();
+        header.width = static_cast<uint8_t>(width);
+
+        size_t words = WordsFor(width);
+        if (data_.GetSize() + words > data_.GetCapacity()) {
+            data_.Reserve(std::max(data_.GetSize() + words, 2 * data_.GetCapacity()));
+        }
+        data_.Resize(data_.GetSize() + words);
+        uint64_t* block_words = data_.begin() + header.offset;
+        for (size_t i = 0; i + 1 < kBlockSize && width != 0; ++i) {
+            uint64_t delta = Delta(tail_.begin(), i);
+            size_t bit = i * width;
+            size_t offset = bit % 64;
+            block_words[bit / 64] |= delta << offset;
+            if (offset + width > 64) {
+                block_words[bit / 64 + 1] |= delta >> (64 - offset);
+            }
+        }
+
+        blocks_.PushBack(header);
+        tail_.Clear();
+    }
+};
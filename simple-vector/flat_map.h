@@ -0,0 +1,502 @@
+#pragma once
+
+#include <cassert>
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+
+#include "simple_vector.h"
+
+//    :      [first, first + size),
+//    key.         ,
+//    
+template <typename Key, typename Compare>
+const Key* BranchlessLowerBound(const Key* first, size_t size, const Key& key, const Compare& comp) {
+    if (size == 0) {
+        return first;
+    }
+    const Key* base = first;
+    while (size > 1) {
+        size_t half = size / 2;
+        base = comp(base[half - 1], key) ? base + half : base;
+        size -= half;
+    }
+    return base + (comp(*base, key) ? 1 : 0);
+}
+
+//     -   address
+#if defined(_MSC_VER)
+#define FLAT_MAP_PREFETCH(address) _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0)
+#else
+#define FLAT_MAP_PREFETCH(address) __builtin_prefetch(address)
+#endif
+
+//     ( ,        ).
+//       ,          
+// -,         .   
+//       :       
+template <typename Key, typename Compare = std::less<Key>>
+class EytzingerIndex {
+public:
+    EytzingerIndex() = default;
+
+    //      
+    void Build(const SimpleVector<Key>& sorted_keys) {
+        size_t size = sorted_keys.GetSize();
+        SimpleVector<Key> keys(size + 1);
+        size_t next = 0;
+        Fill(sorted_keys, keys, next, 1);
+        keys_.swap(keys);
+        size_ = size;
+        height_ = size == 0 ? 0 : Log2(size);
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+        size_ = 0;
+        height_ = 0;
+    }
+
+    //       ,   key,
+    //   ,   
+    size_t LowerBound(const Key& key, const Compare& comp) const {
+        const Key* keys = keys_.cbegin();
+        size_t k = 1;
+        while (k <= size_) {
+            //   k  log2(kPrefetchStride)    -
+            //   keys[kPrefetchStride * k]:       
+            FLAT_MAP_PREFETCH(keys + std::min(kPrefetchStride * k, size_));
+            k = 2 * k + (comp(keys[k], key) ? 1 : 0);
+        }
+        //        k:
+        //        
+        while (k & 1) {
+            k >>= 1;
+        }
+        k >>= 1;
+        return k == 0 ? size_ : Rank(k);
+    }
+
+private:
+    static constexpr size_t kPrefetchStride = sizeof(Key) < 64 ? 64 / sizeof(Key) : 1;
+
+    SimpleVector<Key> keys_;  // keys_[0]  ,    keys_[1]
+    size_t size_ = 0;
+    size_t height_ = 0;       //    
+
+    static size_t Log2(size_t value) noexcept {
+        size_t result = 0;
+        while (value >>= 1) {
+            ++result;
+        }
+        return result;
+    }
+
+    //   k   .     height_  k
+    //   depth    (2 * (k - 2^depth) + 1) * 2^(height_ - depth) - 1.
+    //          ,
+    //     
+    size_t Rank(size_t k) const noexcept {
+        size_t depth = Log2(k);
+        size_t rank = ((2 * (k - (size_t(1) << depth)) + 1) << (height_ - depth)) - 1;
+        size_t last_level = size_ - (size_t(1) << height_) + 1;
+        size_t before = (rank + 1) / 2;
+        return before > last_level ? rank - (before - last_level) : rank;
+    }
+
+    static void Fill(const SimpleVector<Key>& sorted_keys, SimpleVector<Key>& keys, size_t& next, size_t k) {
+        if (k > sorted_keys.GetSize()) {
+            return;
+        }
+        Fill(sorted_keys, keys, next, 2 * k);
+        keys[k] = sorted_keys[next++];
+        Fill(sorted_keys, keys, next, 2 * k + 1);
+    }
+};
+
+// SimpleVector<bool>           ,
+//     bool     
+struct FlatMapBool {
+    bool value = false;
+
+    FlatMapBool() = default;
+
+    FlatMapBool(bool flag) noexcept : value(flag) {
+    }
+
+    operator bool() const noexcept {
+        return value;
+    }
+};
+
+//    SimpleVector.       
+//  :    ,     
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class FlatMap {
+public:
+    using KeyIterator = typename SimpleVector<Key>::ConstIterator;
+    // ,    : Value  FlatMapBool  bool
+    using StoredValue = std::conditional_t<std::is_same_v<Value, bool>, FlatMapBool, Value>;
+
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& comp) : comp_(comp) {
+    }
+
+    //       -.
+    //    ;     
+    template <typename InputIt>
+    FlatMap(InputIt first, InputIt last, const Compare& comp = Compare()) : comp_(comp) {
+        InsertBatch(first, last);
+    }
+
+    FlatMap(std::initializer_list<std::pair<Key, Value>> init, const Compare& comp = Compare())
+        : FlatMap(init.begin(), init.end(), comp) {
+    }
+
+    size_t GetSize() const noexcept {
+        return keys_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return keys_.IsEmpty();
+    }
+
+    void Reserve(size_t new_capacity) {
+        keys_.Reserve(new_capacity);
+        values_.Reserve(new_capacity);
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+        values_.Clear();
+        InvalidateIndex();
+    }
+
+    //       key  nullptr,   
+    Value* Find(const Key& key) {
+        size_t pos = LowerBound(key);
+        return IsMatch(pos, key) ? &GetValue(pos) : nullptr;
+    }
+
+    const Value* Find(const Key& key) const {
+        size_t pos = LowerBound(key);
+        return IsMatch(pos, key) ? &GetValue(pos) : nullptr;
+    }
+
+    bool Contains(const Key& key) const {
+        return IsMatch(LowerBound(key), key);
+    }
+
+    //       key
+    //   std::out_of_range,   
+    Value& At(const Key& key) {
+        Value* value = Find(key);
+        if (value == nullptr) {
+            throw std::out_of_range("key not found");
+        }
+        return *value;
+    }
+
+    const Value& At(const Key& key) const {
+        const Value* value = Find(key);
+        if (value == nullptr) {
+            throw std::out_of_range("key not found");
+        }
+        return *value;
+    }
+
+    //       key,    ,   
+    Value& operator[](const Key& key) {
+        size_t pos = LowerBound(key);
+        if (!IsMatch(pos, key)) {
+            InsertAt(pos, key, Value());
+        }
+        return GetValue(pos);
+    }
+
+    //   -.    ,   .
+    //  true,   
+    bool Insert(const Key& key, Value value) {
+        size_t pos = LowerBound(key);
+        if (IsMatch(pos, key)) {
+            return false;
+        }
+        InsertAt(pos, key, std::move(value));
+        return true;
+    }
+
+    //     .  ,  
+    //             .
+    //    
+    template <typename InputIt>
+    void InsertBatch(InputIt first, InputIt last) {
+        SimpleVector<std::pair<Key, Value>> batch;
+        for (; first != last; ++first) {
+            batch.PushBack(std::pair<Key, Value>(first->first, first->second));
+        }
+        std::stable_sort(batch.begin(), batch.end(), [this](const auto& lhs, const auto& rhs) {
+            return comp_(lhs.first, rhs.first);
+        });
+
+        SimpleVector<Key> keys;
+        SimpleVector<StoredValue> values;
+        keys.Reserve(keys_.GetSize() + batch.GetSize());
+        values.Reserve(keys_.GetSize() + batch.GetSize());
+
+        size_t i = 0;
+        size_t j = 0;
+        while (i < keys_.GetSize() || j < batch.GetSize()) {
+            if (j == batch.GetSize() || (i < keys_.GetSize() && !comp_(batch[j].first, keys_[i]))) {
+                if (j < batch.GetSize() && !comp_(keys_[i], batch[j].first)) {
+                    ++j;
+                    continue;
+                }
+                keys.PushBack(std::move(keys_[i]));
+                values.PushBack(std::move(values_[i]));
+                ++i;
+            }
+            else {
+                if (keys.IsEmpty() || comp_(keys[keys.GetSize() - 1], batch[j].first)) {
+                    keys.PushBack(std::move(batch[j].first));
+                    values.PushBack(std::move(batch[j].second));
+                }
+                ++j;
+            }
+        }
+        keys_.swap(keys);
+        values_.swap(values);
+        InvalidateIndex();
+    }
+
+    //   key   .  true,    
+    bool Erase(const Key& key) {
+        size_t pos = LowerBound(key);
+        if (!IsMatch(pos, key)) {
+            return false;
+        }
+        keys_.Erase(keys_.cbegin() + pos);
+        values_.Erase(values_.cbegin() + pos);
+        InvalidateIndex();
+        return true;
+    }
+
+    //   .      , 
+    //      .      
+    //       ;     
+    //         
+    void BuildLookupIndex() {
+        index_.Build(keys_);
+        index_valid_ = true;
+    }
+
+    bool HasLookupIndex() const noexcept {
+        return index_valid_;
+    }
+
+    //      
+    const SimpleVector<Key>& GetKeys() const noexcept {
+        return keys_;
+    }
+
+    const SimpleVector<StoredValue>& GetValues() const noexcept {
+        return values_;
+    }
+
+    // ,   GetKeys()[index].     
+    //   ,         
+    Value& GetValue(size_t index) noexcept {
+        assert(index < values_.GetSize());
+        if constexpr (std::is_same_v<Value, bool>) {
+            return values_[index].value;
+        }
+        else {
+            return values_[index];
+        }
+    }
+
+    const Value& GetValue(size_t index) const noexcept {
+        assert(index < values_.GetSize());
+        if constexpr (std::is_same_v<Value, bool>) {
+            return values_[index].value;
+        }
+        else {
+            return values_[index];
+        }
+    }
+
+private:
+    SimpleVector<Key> keys_;
+    SimpleVector<StoredValue> values_;
+    Compare comp_;
+    EytzingerIndex<Key, Compare> index_;
+    bool index_valid_ = false;
+
+    size_t LowerBound(const Key& key) const {
+        if (index_valid_) {
+            return index_.LowerBound(key, comp_);
+        }
+        return BranchlessLowerBound(keys_.cbegin(), keys_.GetSize(), key, comp_) - keys_.cbegin();
+    }
+
+    bool IsMatch(size_t pos, const Key& key) const {
+        return pos < keys_.GetSize() && !comp_(key, keys_[pos]);
+    }
+
+    void InsertAt(size_t pos, const Key& key, Value&& value) {
+        keys_.Insert(keys_.cbegin() + pos, key);
+        values_.Insert(values_.cbegin() + pos, std::move(value));
+        InvalidateIndex();
+    }
+
+    void InvalidateIndex() noexcept {
+        if (index_valid_) {
+            index_.Clear();
+            index_valid_ = false;
+        }
+    }
+};
+
+//    SimpleVector
+template <typename Key, typename Compare = std::less<Key>>
+class FlatSet {
+public:
+    using ConstIterator = typename SimpleVector<Key>::ConstIterator;
+
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare& comp) : comp_(comp) {
+    }
+
+    //     :       
+    template <typename InputIt>
+    FlatSet(InputIt first, InputIt last, const Compare& comp = Compare()) : comp_(comp) {
+        InsertBatch(first, last);
+    }
+
+    FlatSet(std::initializer_list<Key> init, const Compare& comp = Compare())
+        : FlatSet(init.begin(), init.end(), comp) {
+    }
+
+    size_t GetSize() const noexcept {
+        return keys_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return keys_.IsEmpty();
+    }
+
+    void Reserve(size_t new_capacity) {
+        keys_.Reserve(new_capacity);
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+        InvalidateIndex();
+    }
+
+    bool Contains(const Key& key) const {
+        size_t pos = LowerBound(key);
+        return pos < keys_.GetSize() && !comp_(key, keys_[pos]);
+    }
+
+    //     key  end(),   
+    ConstIterator Find(const Key& key) const {
+        size_t pos = LowerBound(key);
+        return pos < keys_.GetSize() && !comp_(key, keys_[pos]) ? keys_.cbegin() + pos : keys_.cend();
+    }
+
+    //  .  true,     
+    bool Insert(const Key& key) {
+        size_t pos = LowerBound(key);
+        if (pos < keys_.GetSize() && !comp_(key, keys_[pos])) {
+            return false;
+        }
+        keys_.Insert(keys_.cbegin() + pos, key);
+        InvalidateIndex();
+        return true;
+    }
+
+    //     ,       
+    template <typename InputIt>
+    void InsertBatch(InputIt first, InputIt last) {
+        SimpleVector<Key> batch;
+        for (; first != last; ++first) {
+            batch.PushBack(Key(*first));
+        }
+        std::sort(batch.begin(), batch.end(), comp_);
+
+        SimpleVector<Key> keys;
+        keys.Reserve(keys_.GetSize() + batch.GetSize());
+
+        size_t i = 0;
+        size_t j = 0;
+        while (i < keys_.GetSize() || j < batch.GetSize()) {
+            bool take_existing = j == batch.GetSize()
+                || (i < keys_.GetSize() && !comp_(batch[j], keys_[i]));
+            Key& key = take_existing ? keys_[i++] : batch[j++];
+            if (keys.IsEmpty() || comp_(keys[keys.GetSize() - 1], key)) {
+                keys.PushBack(std::move(key));
+            }
+        }
+        keys_.swap(keys);
+        InvalidateIndex();
+    }
+
+    //  .  true,    
+    bool Erase(const Key& key) {
+        size_t pos = LowerBound(key);
+        if (pos == keys_.GetSize() || comp_(key, keys_[pos])) {
+            return false;
+        }
+        keys_.Erase(keys_.cbegin() + pos);
+        InvalidateIndex();
+        return true;
+    }
+
+    //   ;     .
+    //             
+    void BuildLookupIndex() {
+        index_.Build(keys_);
+        index_valid_ = true;
+    }
+
+    bool HasLookupIndex() const noexcept {
+        return index_valid_;
+    }
+
+    ConstIterator begin() const noexcept {
+        return keys_.cbegin();
+    }
+
+    ConstIterator end() const noexcept {
+        return keys_.cend();
+    }
+
+private:
+    SimpleVector<Key> keys_;
+    Compare comp_;
+    EytzingerIndex<Key, Compare> index_;
+    bool index_valid_ = false;
+
+    size_t LowerBound(const Key& key) const {
+        if (index_valid_) {
+            return index_.LowerBound(key, comp_);
+        }
+        return BranchlessLowerBound(keys_.cbegin(), keys_.GetSize(), key, comp_) - keys_.cbegin();
+    }
+
+    void InvalidateIndex() noexcept {
+        if (index_valid_) {
+            index_.Clear();
+            index_valid_ = false;
+        }
+    }
+};
@@ -1,8 +1,13 @@
 #include "simple_vector.h"
+#include "flat_map.h"
+#include "compressed_simple_vector.h"
+#include "vector_expressions.h"
 
 #include <cassert>
+#include <cmath>
 #include <iostream>
 #include <numeric>
+#include <string>
 
 using namespace std;
 
@@ -149,6 +154,308 @@ void TestNoncopiableErase() {
     cout << "Done!" << endl << endl;
 }
 
+void TestFlatMap() {
+    cout << "Test flat map" << endl;
+    FlatMap<int, string> m{ {3, "c"s}, {1, "a"s}, {2, "b"s}, {1, "x"s} };
+    assert(m.GetSize() == 3);
+    assert(m.At(1) == "a"s);
+    assert(m.Find(4) == nullptr);
+
+    assert(m.Insert(0, "z"s));
+    assert(!m.Insert(0, "y"s));
+    m[5] = "e"s;
+    assert(m.GetSize() == 5);
+    assert(m.GetKeys()[0] == 0 && m.GetKeys()[4] == 5);
+
+    pair<int, string> batch[] = { {7, "g"s}, {2, "q"s}, {6, "f"s}, {7, "h"s}, {4, "d"s} };
+    m.InsertBatch(begin(batch), end(batch));
+    assert(m.GetSize() == 8);
+    for (size_t i = 0; i < m.GetSize(); ++i) {
+        assert(m.GetKeys()[i] == static_cast<int>(i));
+    }
+    assert(m.At(2) == "b"s);
+    assert(m.At(7) == "g"s);
+    m.GetValue(7) += "g"s;
+    assert(m.At(7) == "gg"s && m.GetValues()[7] == "gg"s);
+
+    assert(m.Erase(3));
+    assert(!m.Erase(3));
+    assert(!m.Contains(3));
+
+    m.BuildLookupIndex();
+    assert(m.HasLookupIndex());
+    for (int key = -1; key < 10; ++key) {
+        assert(m.Contains(key) == (key >= 0 && key <= 7 && key != 3));
+    }
+    assert(*m.Find(6) == "f"s);
+    m.Insert(3, "c"s);
+    assert(!m.HasLookupIndex());
+    assert(m.At(3) == "c"s);
+
+    try {
+        m.At(42);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+
+    FlatMap<int, bool> flags{ {2, true}, {1, false} };
+    flags[3] = true;
+    assert(flags.Insert(0, true));
+    assert(flags.GetSize() == 4);
+    assert(*flags.Find(0) && !*flags.Find(1) && flags.At(2));
+    *flags.Find(1) = true;
+    assert(flags.At(1));
+    flags.GetValue(1) = false;
+    assert(!flags.At(1) && !flags.GetValues()[1]);
+    assert(flags.Erase(2));
+    flags.BuildLookupIndex();
+    assert(flags.Find(2) == nullptr && flags.At(3));
+    cout << "Done!" << endl << endl;
+}
+
+void TestFlatSet() {
+    const size_t size = 1000;
+    cout << "Test flat set" << endl;
+    SimpleVector<int> values;
+    for (size_t i = 0; i < size; ++i) {
+        values.PushBack(static_cast<int>(i * 7919 % size) * 2);
+    }
+    FlatSet<int> s(values.begin(), values.end());
+    s.InsertBatch(values.begin(), values.end());
+    assert(s.GetSize() == size);
+    assert(is_sorted(s.begin(), s.end()));
+
+    for (int with_index = 0; with_index < 2; ++with_index) {
+        if (with_index) {
+            s.BuildLookupIndex();
+        }
+        for (int key = -1; key <= static_cast<int>(size) * 2; ++key) {
+            assert(s.Contains(key) == (key >= 0 && key < static_cast<int>(size) * 2 && key % 2 == 0));
+        }
+    }
+
+    assert(s.Insert(1));
+    assert(!s.Insert(1));
+    assert(s.Erase(0));
+    assert(s.Find(0) == s.end());
+    assert(*s.Find(1) == 1);
+    cout << "Done!" << endl << endl;
+}
+
+void TestPackedSimpleVector() {
+    const size_t size = 1000;
+    cout << "Test packed vector" << endl;
+    PackedSimpleVector<20> v;
+    v.Reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        v.PushBack(static_cast<uint32_t>(i * 1031 % (1 << 20)));
+    }
+    assert(v.GetSize() == size);
+    assert(v.GetMemoryUsage() * 32 < size * sizeof(uint32_t) * 21);
+    for (size_t i = 0; i < size; ++i) {
+        assert(v[i] == i * 1031 % (1 << 20));
+    }
+
+    v[3] = (1 << 20) + 7;
+    assert(v[3] == 7);
+    auto it = v.Erase(v.begin() + 3);
+    assert(it - v.begin() == 3);
+    assert(v.GetSize() == size - 1);
+    assert(v[3] == 4 * 1031);
+    it = v.Insert(v.begin() + 3, 3 * 1031);
+    assert(it - v.begin() == 3);
+    assert(v.GetSize() == size);
+    for (size_t i = 0; i < size; ++i) {
+        assert(v[i] == (i == 3 ? 3 * 1031 : i * 1031 % (1 << 20)));
+    }
+
+    SimpleVector<uint32_t> plain = v.Unpack();
+    assert(plain.GetSize() == v.GetSize());
+    assert(equal(plain.begin(), plain.end(), v.begin()));
+
+    v.Resize(2);
+    v.Resize(4);
+    assert(v[2] == 0 && v[3] == 0);
+    assert(v.FindFirstSet() == 1);
+
+    PackedSimpleVector<4> nibbles{ 1, 2, 3, 0, 15 };
+    PackedSimpleVector<4> mask{ 0, 15, 15, 15, 15 };
+    nibbles &= mask;
+    assert(nibbles == (PackedSimpleVector<4>{ 0, 2, 3, 0, 15 }));
+    nibbles.Erase(nibbles.begin());
+    assert(nibbles == (PackedSimpleVector<4>{ 2, 3, 0, 15 }));
+    nibbles.Insert(nibbles.begin() + 1, 9);
+    assert(nibbles == (PackedSimpleVector<4>{ 2, 9, 3, 0, 15 }));
+    nibbles.Erase(nibbles.begin() + 1);
+    assert(nibbles.Count() == 7);
+    assert(nibbles.FindNextSet(2) == 3);
+    cout << "Done!" << endl << endl;
+}
+
+void TestBoolSimpleVector() {
+    const size_t size = 1000;
+    cout << "Test bool vector" << endl;
+    SimpleVector<bool> flags(size);
+    assert(flags.GetSize() == size);
+    assert(flags.FindFirstSet() == size);
+    for (size_t i = 0; i < size; i += 3) {
+        flags[i] = true;
+    }
+    assert(flags.Count() == (size + 2) / 3);
+    assert(flags.FindNextSet(1) == 3);
+
+    bool unpacked[size];
+    flags.Unpack(unpacked);
+    for (size_t i = 0; i < size; ++i) {
+        assert(unpacked[i] == (i % 3 == 0));
+        assert(flags[i] == unpacked[i]);
+    }
+    SimpleVector<uint8_t> bytes = flags.Unpack();
+    assert(bytes.GetSize() == size);
+    assert(equal(bytes.begin(), bytes.end(), unpacked));
+
+    SimpleVector<bool> other(size, true);
+    other ^= flags;
+    assert(other.Count() == size - flags.Count());
+    other.Flip();
+    assert(other == flags);
+    assert(SimpleVector<bool>(3) != SimpleVector<bool>(5));
+    assert(!(SimpleVector<bool>(3) == SimpleVector<bool>(5)));
+
+    flags.Erase(flags.begin());
+    assert(!flags[0] && !flags[1] && flags[2]);
+    flags.PushBack(true);
+    assert(flags.GetSize() == size);
+    assert(flags[size - 1]);
+    flags.Insert(flags.begin(), true);
+    assert(flags[0] && !flags[1] && flags[3] && flags[size]);
+    assert(flags.GetSize() == size + 1);
+    cout << "Done!" << endl << endl;
+}
+
+void TestCompressedSimpleVector() {
+    const size_t size = 100000;
+    cout << "Test compressed vector" << endl;
+    SimpleVector<uint64_t> timestamps(size);
+    uint64_t timestamp = 1700000000000ull;
+    for (size_t i = 0; i < size; ++i) {
+        timestamp += i % 7 * 100 + i % 3;
+        timestamps[i] = timestamp;
+    }
+
+    CompressedSimpleVector<> compressed(timestamps);
+    assert(compressed.GetSize() == size);
+    assert(compressed.GetMemoryUsage() * 4 < size * sizeof(uint64_t));
+    for (size_t i = 0; i < size; i += 97) {
+        assert(compressed[i] == timestamps[i]);
+    }
+    assert(compressed.At(size - 1) == timestamps[size - 1]);
+
+    SimpleVector<uint64_t> decompressed = compressed.Decompress();
+    assert(equal(decompressed.begin(), decompressed.end(), timestamps.begin(), timestamps.end()));
+    assert(equal(compressed.begin(), compressed.end(), timestamps.begin(), timestamps.end()));
+    auto it = compressed.begin();
+    assert(*it++ == timestamps[0]);
+    assert(*it == timestamps[1]);
+
+    CompressedSimpleVector<int> mixed;
+    for (int i = 0; i < 1000; ++i) {
+        mixed.PushBack(i % 2 == 0 ? -i : i * 1000);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        assert(mixed[i] == (i % 2 == 0 ? -i : i * 1000));
+    }
+
+    try {
+        mixed.At(1000);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+    cout << "Done!" << endl << endl;
+}
+
+void TestVectorExpressions() {
+    const size_t size = 1003;
+    cout << "Test vector expressions" << endl;
+    SimpleVector<float> a(size);
+    SimpleVector<float> b(size);
+    SimpleVector<float> c(size);
+    for (size_t i = 0; i < size; ++i) {
+        a[i] = static_cast<float>(i % 17) - 8.0f;
+        b[i] = static_cast<float>(i % 5) * 0.5f;
+        c[i] = static_cast<float>(i % 3) + 1.0f;
+    }
+
+    const SimdLevel detected = DetectSimdLevel();
+    for (SimdLevel level : { SimdLevel::kScalar, SimdLevel::kSse2, SimdLevel::kAvx2, SimdLevel::kAvx512 }) {
+        SetSimdLevel(level);
+
+        SimpleVector<float> result(Reserve(size));
+        const float* data = result.begin();
+        Assign(result, a + b * c);
+        assert(result.GetSize() == size);
+        assert(result.begin() == data);
+        for (size_t i = 0; i < size; ++i) {
+            assert(result[i] == a[i] + b[i] * c[i]);
+        }
+
+        Assign(result, Clamp(-a / 2.0f, -1.5f, 2.0f));
+        for (size_t i = 0; i < size; ++i) {
+            assert(result[i] == min(max(-a[i] / 2.0f, -1.5f), 2.0f));
+        }
+
+        Assign(result, Select(Less(1.0f, c), 1.0f / c, 0.0f));
+        for (size_t i = 0; i < size; ++i) {
+            assert(result[i] == (1.0f < c[i] ? 1.0f / c[i] : 0.0f));
+        }
+
+        Assign(result, Select(Less(a, 0) & ~Equal(b, 0), Abs(a), Sqrt(c)));
+        for (size_t i = 0; i < size; ++i) {
+            assert(result[i] == (a[i] < 0 && b[i] != 0 ? abs(a[i]) : sqrt(c[i])));
+        }
+
+        result = a;
+        Assign(result, result * 2 + result);
+        for (size_t i = 0; i < size; ++i) {
+            assert(result[i] == a[i] * 3);
+        }
+
+        float dot = 0;
+        size_t negative = 0;
+        for (size_t i = 0; i < size; ++i) {
+            dot += a[i] * c[i];
+            negative += a[i] < 0 ? 1 : 0;
+        }
+        assert(abs(Dot(a, c) - dot) < 1e-3f);
+        assert(abs(Sum(a * c) - dot) < 1e-3f);
+        assert(Count(Less(a, 0.0f)) == negative);
+        assert(Count(GreaterEqual(a, 0.0f) | Less(a, 0.0f)) == size);
+        size_t negative_nonzero_b = 0;
+        for (size_t i = 0; i < size; ++i) {
+            negative_nonzero_b += a[i] < 0 && b[i] != 0 ? 1 : 0;
+        }
+        assert(Count(~Equal(b, 0) & Less(a, 0)) == negative_nonzero_b);
+        assert(Count(Less(a, 0) & ~~~Equal(b, 0)) == negative_nonzero_b);
+        assert(MinElement(a) == -8.0f);
+        assert(MaxElement(a - c) == 7.0f);
+    }
+    SetSimdLevel(detected);
+
+    SimpleVector<double> x{ 1.0, 4.0, 9.0 };
+    SimpleVector<double> roots = Evaluate(Sqrt(x) + 1);
+    assert(roots == (SimpleVector<double>{ 2.0, 3.0, 4.0 }));
+
+    //   -  ,   :       
+    SimpleVector<double> empty;
+    assert(!HaveSameSize(MakeOperand<double>(x), MakeOperand<double>(empty)));
+    assert(!HaveSameSize(MakeOperand<double>(empty), MakeOperand<double>(x + 1)));
+    assert(HaveSameSize(MakeOperand<double>(x), MakeOperand<double>(2.0)));
+    SimpleVector<double> nothing = Evaluate(empty + empty * 2.0);
+    assert(nothing.IsEmpty());
+    assert(Sum(empty + empty) == 0.0);
+    cout << "Done!" << endl << endl;
+}
+
 int main() {
     TestTemporaryObjConstructor();
     TestTemporaryObjOperator();
@@ -158,5 +465,11 @@ int main() {
     TestNoncopiablePushBack();
     TestNoncopiableInsert();
     TestNoncopiableErase();
+    TestFlatMap();
+    TestFlatSet();
+    TestPackedSimpleVector();
+    TestBoolSimpleVector();
+    TestCompressedSimpleVector();
+    TestVectorExpressions();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,576 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define PACKED_SIMPLE_VECTOR_SSE2
+#endif
+
+#include "bit_operations.h"
+#include "simple_vector.h"
+
+//     Bits ,    64- .
+//     .      ,
+//          
+template <unsigned Bits, typename Value = std::conditional_t<(Bits <= 32), uint32_t, uint64_t>>
+class PackedSimpleVector {
+    static_assert(Bits >= 1 && Bits <= 64, "Bits must be in [1, 64]");
+
+    static constexpr size_t kWordBits = 64;
+    static constexpr uint64_t kMask = Bits == kWordBits ? ~uint64_t(0) : (uint64_t(1) << Bits) - 1;
+
+public:
+    // -   
+    class Reference {
+    public:
+        Reference(PackedSimpleVector* vector, size_t index) noexcept : vector_(vector), index_(index) {
+        }
+
+        operator Value() const noexcept {
+            return static_cast<Value>(vector_->Load(index_));
+        }
+
+        Reference& operator=(Value value) noexcept {
+            vector_->Store(index_, static_cast<uint64_t>(value));
+            return *this;
+        }
+
+        Reference& operator=(const Reference& other) noexcept {
+            return *this = static_cast<Value>(other);
+        }
+
+    private:
+        PackedSimpleVector* vector_;
+        size_t index_;
+    };
+
+    template <bool IsConst>
+    class BasicIterator {
+        using Container = std::conditional_t<IsConst, const PackedSimpleVector, PackedSimpleVector>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::conditional_t<IsConst, Value, Reference>;
+
+        BasicIterator() = default;
+
+        BasicIterator(Container* vector, size_t index) noexcept : vector_(vector), index_(index) {
+        }
+
+        //     
+        operator BasicIterator<true>() const noexcept {
+            return BasicIterator<true>(vector_, index_);
+        }
+
+        reference operator*() const noexcept {
+            return (*vector_)[index_];
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return (*vector_)[index_ + offset];
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator copy(*this);
+            ++index_;
+            return copy;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator copy(*this);
+            --index_;
+            return copy;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        BasicIterator operator+(difference_type offset) const noexcept {
+            return BasicIterator(vector_, index_ + offset);
+        }
+
+        friend BasicIterator operator+(difference_type offset, const BasicIterator& it) noexcept {
+            return it + offset;
+        }
+
+        BasicIterator operator-(difference_type offset) const noexcept {
+            return BasicIterator(vector_, index_ - offset);
+        }
+
+        difference_type operator-(const BasicIterator& other) const noexcept {
+            return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+        }
+
+        bool operator==(const BasicIterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const BasicIterator& other) const noexcept {
+            return index_ != other.index_;
+        }
+
+        bool operator<(const BasicIterator& other) const noexcept {
+            return index_ < other.index_;
+        }
+
+        bool operator>(const BasicIterator& other) const noexcept {
+            return index_ > other.index_;
+        }
+
+        bool operator<=(const BasicIterator& other) const noexcept {
+            return index_ <= other.index_;
+        }
+
+        bool operator>=(const BasicIterator& other) const noexcept {
+            return index_ >= other.index_;
+        }
+
+        size_t GetIndex() const noexcept {
+            return index_;
+        }
+
+    private:
+        Container* vector_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    //   ,   Unpack()
+    using UnpackedValue = std::conditional_t<std::is_same_v<Value, bool>, uint8_t, Value>;
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    PackedSimpleVector() noexcept = default;
+
+    //    size  
+    explicit PackedSimpleVector(size_t size) : words_(WordsFor(size)), size_(size) {
+    }
+
+    //    size ,  value
+    PackedSimpleVector(size_t size, Value value) : PackedSimpleVector(size) {
+        if ((static_cast<uint64_t>(value) & kMask) != 0) {
+            for (size_t i = 0; i < size_; ++i) {
+                Store(i, static_cast<uint64_t>(value));
+            }
+        }
+    }
+
+    PackedSimpleVector(std::initializer_list<Value> init) : PackedSimpleVector(init.size()) {
+        size_t i = 0;
+        for (Value value : init) {
+            Store(i++, static_cast<uint64_t>(value));
+        }
+    }
+
+    //  
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    //  ,     
+    size_t GetCapacity() const noexcept {
+        return words_.GetCapacity() * kWordBits / Bits;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    //  ,   
+    size_t GetMemoryUsage() const noexcept {
+        return words_.GetCapacity() * sizeof(uint64_t);
+    }
+
+    void Reserve(size_t new_capacity) {
+        words_.Reserve(WordsFor(new_capacity));
+    }
+
+    Reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Reference(this, index);
+    }
+
+    Value operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return static_cast<Value>(Load(index));
+    }
+
+    //   std::out_of_range,  index >= size
+    Reference At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("index >= size");
+        }
+        return Reference(this, index);
+    }
+
+    Value At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("index >= size");
+        }
+        return static_cast<Value>(Load(index));
+    }
+
+    //     .   value,    Bits, 
+    void PushBack(Value value) {
+        if (WordsFor(size_ + 1) > words_.GetSize()) {
+            words_.PushBack(0);
+        }
+        Store(size_, static_cast<uint64_t>(value));
+        ++size_;
+    }
+
+    void PopBack() noexcept {
+        if (size_ > 0) {
+            Store(size_ - 1, 0);
+            --size_;
+            words_.Resize(WordsFor(size_));
+        }
+    }
+
+    //  value  pos,    .
+    //     
+    Iterator Insert(ConstIterator pos, Value value) {
+        size_t index = pos.GetIndex();
+        assert(index <= size_);
+        if constexpr (Bits == kWordBits) {
+            words_.Insert(words_.cbegin() + index, static_cast<uint64_t>(value));
+            ++size_;
+            return Iterator(this, index);
+        }
+        else {
+            if (WordsFor(size_ + 1) > words_.GetSize()) {
+                words_.PushBack(0);
+            }
+            if constexpr (kWordBits % Bits == 0) {
+                size_t bit = index * Bits;
+                size_t word_index = bit / kWordBits;
+                size_t offset = bit % kWordBits;
+                for (size_t i = words_.GetSize() - 1; i > word_index; --i) {
+                    words_[i] = (words_[i] << Bits) | (words_[i - 1] >> (kWordBits - Bits));
+                }
+                uint64_t low_mask = offset == 0 ? 0 : ~uint64_t(0) >> (kWordBits - offset);
+                uint64_t& word = words_[word_index];
+                word = (word & low_mask) | ((word & ~low_mask) << Bits);
+            }
+            else {
+                for (size_t i = size_; i > index; --i) {
+                    Store(i, Load(i - 1));
+                }
+            }
+            ++size_;
+            Store(index, static_cast<uint64_t>(value));
+            return Iterator(this, index);
+        }
+    }
+
+    //     pos,    
+    Iterator Erase(ConstIterator pos) {
+        size_t index = pos.GetIndex();
+        assert(index < size_);
+        if constexpr (Bits == kWordBits) {
+            words_.Erase(words_.cbegin() + index);
+        }
+        else if constexpr (kWordBits % Bits == 0) {
+            size_t bit = index * Bits;
+            size_t word_index = bit / kWordBits;
+            size_t offset = bit % kWordBits;
+            uint64_t low_mask = offset == 0 ? 0 : ~uint64_t(0) >> (kWordBits - offset);
+            uint64_t& word = words_[word_index];
+            word = (word & low_mask) | ((word >> Bits) & ~low_mask);
+            for (size_t i = word_index + 1; i < words_.GetSize(); ++i) {
+                words_[i - 1] |= words_[i] << (kWordBits - Bits);
+                words_[i] >>= Bits;
+            }
+        }
+        else {
+            for (size_t i = index; i + 1 < size_; ++i) {
+                Store(i, Load(i + 1));
+            }
+            Store(size_ - 1, 0);
+        }
+        --size_;
+        words_.Resize(WordsFor(size_));
+        return Iterator(this, index);
+    }
+
+    //   .    
+    void Resize(size_t new_size) {
+        words_.Resize(WordsFor(new_size));
+        size_ = new_size;
+        ClearTail();
+    }
+
+    void Clear() noexcept {
+        words_.Clear();
+        size_ = 0;
+    }
+
+    void swap(PackedSimpleVector& other) noexcept {
+        words_.swap(other.words_);
+        std::swap(size_, other.size_);
+    }
+
+    //      ;  Bits == 1    
+    size_t Count() const noexcept {
+        size_t count = 0;
+        for (size_t i = 0; i < words_.GetSize(); ++i) {
+            count += PopCount(words_[i]);
+        }
+        return count;
+    }
+
+    //    ,   from,  GetSize(),   
+    size_t FindNextSet(size_t from) const noexcept {
+        if (from >= size_) {
+            return size_;
+        }
+        size_t bit = from * Bits;
+        size_t word_index = bit / kWordBits;
+        uint64_t word = words_[word_index] & (~uint64_t(0) << (bit % kWordBits));
+        while (word == 0) {
+            if (++word_index == words_.GetSize()) {
+                return size_;
+            }
+            word = words_[word_index];
+        }
+        return (word_index * kWordBits + CountTrailingZeros(word)) / Bits;
+    }
+
+    size_t FindFirstSet() const noexcept {
+        return FindNextSet(0);
+    }
+
+    //      ,    
+    PackedSimpleVector& operator&=(const PackedSimpleVector& rhs) noexcept {
+        assert(size_ == rhs.size_);
+        for (size_t i = 0; i < words_.GetSize(); ++i) {
+            words_[i] &= rhs.words_[i];
+        }
+        return *this;
+    }
+
+    PackedSimpleVector& operator|=(const PackedSimpleVector& rhs) noexcept {
+        assert(size_ == rhs.size_);
+        for (size_t i = 0; i < words_.GetSize(); ++i) {
+            words_[i] |= rhs.words_[i];
+        }
+        return *this;
+    }
+
+    PackedSimpleVector& operator^=(const PackedSimpleVector& rhs) noexcept {
+        assert(size_ == rhs.size_);
+        for (size_t i = 0; i < words_.GetSize(); ++i) {
+            words_[i] ^= rhs.words_[i];
+        }
+        return *this;
+    }
+
+    //     
+    void Flip() noexcept {
+        for (size_t i = 0; i < words_.GetSize(); ++i) {
+            words_[i] = ~words_[i];
+        }
+        ClearTail();
+    }
+
+    //     out    GetSize().  
+    //     (. UnpackTo).  Bits == 1   Value  16    SSE2- 
+    void Unpack(Value* out) const noexcept {
+        UnpackTo(out);
+    }
+
+    //     . SimpleVector<bool>    ,
+    //     SimpleVector<uint8_t>   0  1
+    SimpleVector<UnpackedValue> Unpack() const {
+        SimpleVector<UnpackedValue> result(size_);
+        UnpackTo(result.begin());
+        return result;
+    }
+
+    //  ;      
+    const SimpleVector<uint64_t>& GetWords() const noexcept {
+        return words_;
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, size_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, size_);
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator cend() const noexcept {
+        return ConstIterator(this, size_);
+    }
+
+private:
+    SimpleVector<uint64_t> words_;
+    size_t size_ = 0;
+
+    static size_t WordsFor(size_t size) noexcept {
+        return (size * Bits + kWordBits - 1) / kWordBits;
+    }
+
+    uint64_t Load(size_t index) const noexcept {
+        size_t bit = index * Bits;
+        size_t word_index = bit / kWordBits;
+        size_t offset = bit % kWordBits;
+        uint64_t value = words_[word_index] >> offset;
+        if (offset + Bits > kWordBits) {
+            value |= words_[word_index + 1] << (kWordBits - offset);
+        }
+        return value & kMask;
+    }
+
+    void Store(size_t index, uint64_t value) noexcept {
+        value &= kMask;
+        size_t bit = index * Bits;
+        size_t word_index = bit / kWordBits;
+        size_t offset = bit % kWordBits;
+        words_[word_index] = (words_[word_index] & ~(kMask << offset)) | (value << offset);
+        if (offset + Bits > kWordBits) {
+            size_t spill = kWordBits - offset;
+            words_[word_index + 1] = (words_[word_index + 1] & ~(kMask >> spill)) | (value >> spill);
+        }
+    }
+
+    static constexpr size_t Gcd(size_t lhs, size_t rhs) noexcept {
+        return rhs == 0 ? lhs : Gcd(rhs, lhs % rhs);
+    }
+
+    static constexpr size_t kGroupSize = kWordBits / Gcd(Bits, kWordBits);
+    static constexpr size_t kGroupWords = Bits / Gcd(Bits, kWordBits);
+
+    template <size_t Index, typename Out>
+    static void UnpackElement(const uint64_t* words, Out* out) noexcept {
+        constexpr size_t bit = Index * Bits;
+        constexpr size_t offset = bit % kWordBits;
+        uint64_t value = words[bit / kWordBits] >> offset;
+        if constexpr (offset + Bits > kWordBits) {
+            value |= words[bit / kWordBits + 1] << (kWordBits - offset);
+        }
+        out[Index] = static_cast<Out>(value & kMask);
+    }
+
+    template <typename Out, size_t... Indices>
+    static void UnpackGroup(const uint64_t* words, Out* out, std::index_sequence<Indices...>) noexcept {
+        (UnpackElement<Indices>(words, out), ...);
+    }
+
+    //      : Unpack()     uint8_t
+    template <typename Out>
+    void UnpackTo(Out* out) const noexcept {
+        size_t i = 0;
+#ifdef PACKED_SIMPLE_VECTOR_SSE2
+        if constexpr (Bits == 1 && sizeof(Out) == 1) {
+            const __m128i select = _mm_set_epi8(
+                -128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+            const __m128i one = _mm_set1_epi8(1);
+            for (; i + 16 <= size_; i += 16) {
+                uint64_t chunk = words_[i / kWordBits] >> (i % kWordBits);
+                //       0-7,  -   8-15
+                __m128i bytes = _mm_cvtsi32_si128(static_cast<int>(chunk & 0xffff));
+                bytes = _mm_unpacklo_epi8(bytes, bytes);
+                bytes = _mm_unpacklo_epi16(bytes, bytes);
+                bytes = _mm_unpacklo_epi32(bytes, bytes);
+                __m128i flags = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(bytes, select), select), one);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), flags);
+            }
+        }
+#endif
+        //  kGroupWords    kGroupSize ,   
+        //     :    ,
+        //   ,        
+        for (; i + kGroupSize <= size_ && i % kGroupSize == 0; i += kGroupSize) {
+            UnpackGroup(words_.cbegin() + i / kGroupSize * kGroupWords, out + i,
+                        std::make_index_sequence<kGroupSize>());
+        }
+        for (; i < size_; ++i) {
+            out[i] = static_cast<Out>(Load(i));
+        }
+    }
+
+    //     
+    void ClearTail() noexcept {
+        size_t tail = size_ * Bits % kWordBits;
+        if (tail != 0) {
+            words_[words_.GetSize() - 1] &= (uint64_t(1) << tail) - 1;
+        }
+    }
+};
+
+template <unsigned Bits, typename Value>
+inline bool operator==(const PackedSimpleVector<Bits, Value>& lhs, const PackedSimpleVector<Bits, Value>& rhs) {
+    return lhs.GetSize() == rhs.GetSize()
+        && std::equal(lhs.GetWords().begin(), lhs.GetWords().end(), rhs.GetWords().begin());
+}
+
+template <unsigned Bits, typename Value>
+inline bool operator!=(const PackedSimpleVector<Bits, Value>& lhs, const PackedSimpleVector<Bits, Value>& rhs) {
+    return !(lhs == rhs);
+}
+
+//        
+template <>
+class SimpleVector<bool> : public PackedSimpleVector<1, bool> {
+public:
+    using PackedSimpleVector<1, bool>::PackedSimpleVector;
+
+    SimpleVector() noexcept = default;
+
+    SimpleVector(ReserveProxyObj new_capacity) {
+        Reserve(new_capacity.GetCapacity());
+    }
+};
+
+//       SimpleVector<Type>   
+//  
+inline bool operator==(const SimpleVector<bool>& lhs, const SimpleVector<bool>& rhs) {
+    using Packed = PackedSimpleVector<1, bool>;
+    return static_cast<const Packed&>(lhs) == static_cast<const Packed&>(rhs);
+}
+
+inline bool operator!=(const SimpleVector<bool>& lhs, const SimpleVector<bool>& rhs) {
+    return !(lhs == rhs);
+}
@@ -30,7 +30,7 @@ public:
 
     //    size ,    
     explicit SimpleVector(size_t size) : capacity_(size), size_(size), simple_vector_ptr_(size) {
-        std::fill(begin(), end(), 0);
+        std::generate(begin(), end(), [] { return Type(); });
     }
 
     //    size ,   value
@@ -145,8 +145,8 @@ public:
         else {
             size_t new_capacity = NewCapacity();
             ArrayPtr<Type> arr_ptr(new_capacity);
-            std::copy(cbegin(), cend(), arr_ptr.Get());
-            std::copy_backward(pos, cend(), begin() + size_ + 1);
+            std::copy(cbegin(), pos, arr_ptr.Get());
+            std::copy(pos, cend(), arr_ptr.Get() + pos_element + 1);
             arr_ptr[pos_element] = value;
             simple_vector_ptr_.swap(arr_ptr);
             capacity_ = new_capacity;
@@ -358,4 +358,6 @@ inline bool operator>(const SimpleVector<Type>& lhs, const SimpleVector<Type>& r
 template <typename Type>
 inline bool operator>=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
     return !(lhs < rhs);
-}
\ No newline at end of file
+}
+
+#include "packed_simple_vector.h"
\ No newline at end of file
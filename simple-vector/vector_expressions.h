@@ -0,0 +1,575 @@
+#pragma once
+
+#include <cassert>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include "simple_vector.h"
+#include "vector_kernels.h"
+
+//     SimpleVector<float>  SimpleVector<double>.
+//  a + b * c    ,    , 
+//    Assign, Evaluate    .   
+//  kExpressionChunkSize :        SIMD
+//        .     L1,   
+//      .
+//      ,        ,
+//   
+
+constexpr size_t kExpressionChunkSize = 256;
+
+//     
+struct VectorExpressionTag {
+};
+
+template <typename T>
+class VectorOperand : public VectorExpressionTag {
+public:
+    using ValueType = T;
+    static constexpr bool kIsMask = false;
+
+    explicit VectorOperand(const SimpleVector<T>& vector) noexcept : data_(vector.begin()), size_(vector.GetSize()) {
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    bool Aliases(const T* data) const noexcept {
+        return data_ == data;
+    }
+
+    //     [offset, offset + count) .
+    //      buffer      
+    const T* Evaluate(size_t offset, size_t, T*, const VectorKernels<T>&) const noexcept {
+        return data_ + offset;
+    }
+
+private:
+    const T* data_;
+    size_t size_;
+};
+
+// ,    .      ;
+// GetSize()  0,       .
+//      ,     Select
+template <typename T>
+class ScalarOperand : public VectorExpressionTag {
+public:
+    using ValueType = T;
+    static constexpr bool kIsMask = false;
+
+    explicit ScalarOperand(T value) noexcept : value_(value) {
+    }
+
+    size_t GetSize() const noexcept {
+        return 0;
+    }
+
+    bool Aliases(const T*) const noexcept {
+        return false;
+    }
+
+    T GetValue() const noexcept {
+        return value_;
+    }
+
+    const T* Evaluate(size_t, size_t count, T* buffer, const VectorKernels<T>& kernels) const noexcept {
+        kernels.fill(value_, buffer, count);
+        return buffer;
+    }
+
+private:
+    T value_;
+};
+
+template <typename Operand>
+constexpr bool IsScalarOperand() {
+    return std::is_same_v<Operand, ScalarOperand<typename Operand::ValueType>>;
+}
+
+//    :     ,  ,
+//    ,    
+template <typename Lhs, typename Rhs>
+bool HaveSameSize(const Lhs& lhs, const Rhs& rhs) noexcept {
+    if constexpr (IsScalarOperand<Lhs>() || IsScalarOperand<Rhs>()) {
+        return true;
+    }
+    else {
+        return lhs.GetSize() == rhs.GetSize();
+    }
+}
+
+template <BinaryOp Op, typename Lhs, typename Rhs>
+class BinaryExpression : public VectorExpressionTag {
+public:
+    using ValueType = typename Lhs::ValueType;
+    static constexpr bool kIsMask = Op == BinaryOp::kLess || Op == BinaryOp::kLessEqual
+        || Op == BinaryOp::kEqual || Op == BinaryOp::kNotEqual
+        || Op == BinaryOp::kAnd || Op == BinaryOp::kOr || Op == BinaryOp::kAndNot;
+
+    BinaryExpression(Lhs lhs, Rhs rhs) : lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
+        assert(HaveSameSize(lhs_, rhs_));
+    }
+
+    size_t GetSize() const noexcept {
+        if constexpr (IsScalarOperand<Lhs>()) {
+            return rhs_.GetSize();
+        }
+        else {
+            return lhs_.GetSize();
+        }
+    }
+
+    bool Aliases(const ValueType* data) const noexcept {
+        return lhs_.Aliases(data) || rhs_.Aliases(data);
+    }
+
+    const ValueType* Evaluate(size_t offset, size_t count, ValueType* buffer,
+                              const VectorKernels<ValueType>& kernels) const {
+        if constexpr (IsScalarOperand<Rhs>()) {
+            const ValueType* lhs = lhs_.Evaluate(offset, count, buffer, kernels);
+            kernels.binary_scalar[static_cast<size_t>(Op)](lhs, rhs_.GetValue(), buffer, count);
+        }
+        else if constexpr (IsScalarOperand<Lhs>()) {
+            const ValueType* rhs = rhs_.Evaluate(offset, count, buffer, kernels);
+            kernels.scalar_binary[static_cast<size_t>(Op)](lhs_.GetValue(), rhs, buffer, count);
+        }
+        else {
+            ValueType rhs_buffer[kExpressionChunkSize];
+            const ValueType* lhs = lhs_.Evaluate(offset, count, buffer, kernels);
+            const ValueType* rhs = rhs_.Evaluate(offset, count, rhs_buffer, kernels);
+            kernels.binary[static_cast<size_t>(Op)](lhs, rhs, buffer, count);
+        }
+        return buffer;
+    }
+
+private:
+    Lhs lhs_;
+    Rhs rhs_;
+};
+
+template <UnaryOp Op, typename Operand>
+class UnaryExpression : public VectorExpressionTag {
+public:
+    using ValueType = typename Operand::ValueType;
+    static constexpr bool kIsMask = Op == UnaryOp::kNot;
+
+    explicit UnaryExpression(Operand operand) : operand_(std::move(operand)) {
+    }
+
+    const Operand& GetOperand() const noexcept {
+        return operand_;
+    }
+
+    size_t GetSize() const noexcept {
+        return operand_.GetSize();
+    }
+
+    bool Aliases(const ValueType* data) const noexcept {
+        return operand_.Aliases(data);
+    }
+
+    const ValueType* Evaluate(size_t offset, size_t count, ValueType* buffer,
+                              const VectorKernels<ValueType>& kernels) const {
+        const ValueType* operand = operand_.Evaluate(offset, count, buffer, kernels);
+        kernels.unary[static_cast<size_t>(Op)](operand, buffer, count);
+        return buffer;
+    }
+
+private:
+    Operand operand_;
+};
+
+template <typename Mask, typename IfTrue, typename IfFalse>
+class SelectExpression : public VectorExpressionTag {
+public:
+    using ValueType = typename Mask::ValueType;
+    static constexpr bool kIsMask = false;
+
+    SelectExpression(Mask mask, IfTrue if_true, IfFalse if_false)
+        : mask_(std::move(mask)), if_true_(std::move(if_true)), if_false_(std::move(if_false)) {
+        assert(HaveSameSize(mask_, if_true_));
+        assert(HaveSameSize(mask_, if_false_));
+    }
+
+    size_t GetSize() const noexcept {
+        return mask_.GetSize();
+    }
+
+    bool Aliases(const ValueType* data) const noexcept {
+        return mask_.Aliases(data) || if_true_.Aliases(data) || if_false_.Aliases(data);
+    }
+
+    const ValueType* Evaluate(size_t offset, size_t count, ValueType* buffer,
+                              const VectorKernels<ValueType>& kernels) const {
+        ValueType mask_buffer[kExpressionChunkSize];
+        ValueType if_false_buffer[kExpressionChunkSize];
+        const ValueType* if_true = if_true_.Evaluate(offset, count, buffer, kernels);
+        const ValueType* mask = mask_.Evaluate(offset, count, mask_buffer, kernels);
+        const ValueType* if_false = if_false_.Evaluate(offset, count, if_false_buffer, kernels);
+        kernels.select(mask, if_true, if_false, buffer, count);
+        return buffer;
+    }
+
+private:
+    Mask mask_;
+    IfTrue if_true_;
+    IfFalse if_false_;
+};
+
+//     , SimpleVector<float>, SimpleVector<double>  
+
+template <typename X>
+struct OperandTraits {
+    static constexpr bool kIsOperand = std::is_arithmetic_v<X>;
+    static constexpr bool kIsScalar = std::is_arithmetic_v<X>;
+    static constexpr bool kIsMask = false;
+    using ValueType = void;
+};
+
+template <typename T>
+struct OperandTraits<SimpleVector<T>> {
+    static constexpr bool kIsOperand = std::is_floating_point_v<T>;
+    static constexpr bool kIsScalar = false;
+    static constexpr bool kIsMask = false;
+    using ValueType = T;
+};
+
+template <BinaryOp Op, typename Lhs, typename Rhs>
+struct OperandTraits<BinaryExpression<Op, Lhs, Rhs>> {
+    static constexpr bool kIsOperand = true;
+    static constexpr bool kIsScalar = false;
+    static constexpr bool kIsMask = BinaryExpression<Op, Lhs, Rhs>::kIsMask;
+    using ValueType = typename BinaryExpression<Op, Lhs, Rhs>::ValueType;
+};
+
+template <UnaryOp Op, typename Operand>
+struct OperandTraits<UnaryExpression<Op, Operand>> {
+    static constexpr bool kIsOperand = true;
+    static constexpr bool kIsScalar = false;
+    static constexpr bool kIsMask = UnaryExpression<Op, Operand>::kIsMask;
+    using ValueType = typename UnaryExpression<Op, Operand>::ValueType;
+};
+
+template <typename Mask, typename IfTrue, typename IfFalse>
+struct OperandTraits<SelectExpression<Mask, IfTrue, IfFalse>> {
+    static constexpr bool kIsOperand = true;
+    static constexpr bool kIsScalar = false;
+    static constexpr bool kIsMask = false;
+    using ValueType = typename Mask::ValueType;
+};
+
+template <typename Lhs, typename Rhs>
+using CommonValueType = std::conditional_t<OperandTraits<Lhs>::kIsScalar,
+    typename OperandTraits<Rhs>::ValueType, typename OperandTraits<Lhs>::ValueType>;
+
+//  ,     :     ,
+//   ,    -  (kMasks)    
+template <typename Lhs, typename Rhs, bool kMasks>
+constexpr bool AreOperands() {
+    using L = OperandTraits<Lhs>;
+    using R = OperandTraits<Rhs>;
+    if constexpr (!L::kIsOperand || !R::kIsOperand || (L::kIsScalar && R::kIsScalar)) {
+        return false;
+    }
+    else if constexpr (kMasks) {
+        return L::kIsMask && R::kIsMask && std::is_same_v<typename L::ValueType, typename R::ValueType>;
+    }
+    else {
+        return !L::kIsMask && !R::kIsMask
+            && (L::kIsScalar || R::kIsScalar || std::is_same_v<typename L::ValueType, typename R::ValueType>);
+    }
+}
+
+template <typename X, bool kMask>
+constexpr bool IsVectorOperand() {
+    using Traits = OperandTraits<X>;
+    if constexpr (!Traits::kIsOperand || Traits::kIsScalar) {
+        return false;
+    }
+    else {
+        return Traits::kIsMask == kMask;
+    }
+}
+
+template <typename T, typename X>
+auto MakeOperand(const X& operand) {
+    if constexpr (std::is_base_of_v<VectorExpressionTag, X>) {
+        return operand;
+    }
+    else if constexpr (OperandTraits<X>::kIsScalar) {
+        return ScalarOperand<T>(static_cast<T>(operand));
+    }
+    else {
+        return VectorOperand<T>(operand);
+    }
+}
+
+template <BinaryOp Op, typename Lhs, typename Rhs>
+auto MakeBinaryExpression(const Lhs& lhs, const Rhs& rhs) {
+    using T = CommonValueType<Lhs, Rhs>;
+    auto lhs_operand = MakeOperand<T>(lhs);
+    auto rhs_operand = MakeOperand<T>(rhs);
+    return BinaryExpression<Op, decltype(lhs_operand), decltype(rhs_operand)>(
+        std::move(lhs_operand), std::move(rhs_operand));
+}
+
+template <UnaryOp Op, typename Operand>
+auto MakeUnaryExpression(const Operand& operand) {
+    auto node = MakeOperand<typename OperandTraits<Operand>::ValueType>(operand);
+    return UnaryExpression<Op, decltype(node)>(std::move(node));
+}
+
+// ----------  ----------
+
+template <typename Lhs, typename Rhs, typename = std::enable_if_t<AreOperands<Lhs, Rhs, false>()>>
+auto operator+(const Lhs& lhs, const Rhs& rhs) {
+    return MakeBinaryExpression<BinaryOp::kAdd>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs, typename = std::enable_if_t<AreOperands<Lhs, Rhs, false>()>>
+auto operator-(const Lhs& lhs, const Rhs& rhs) {
+    return MakeBinaryExpression<BinaryOp::kSub>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs, typename = std::enable_if_t<AreOperands<Lhs, Rhs, false>()>>
+auto operator*(const Lhs& lhs, const Rhs& rhs) {
+    return MakeBinaryExpression<BinaryOp::kMul>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs, typename = std::enable_if_t<AreOperands<Lhs, Rhs, false>()>>
+auto operator/(const Lhs& lhs, const Rhs& rhs) {
+    return MakeBinaryExpression<BinaryOp::kDiv>(lhs, rhs);
+}
+
+template <typename Operand, typename = std::enable_if_t<IsVectorOperand<Operand, false>()>>
+auto operator-(const Operand& operand) {
+    return MakeUnaryExpression<UnaryOp::kNeg>(operand);
+}
+
+template <typename Lhs, typename Rhs, typename = std::enable_if_t<AreOperands<Lhs, Rhs, false>()>>
+auto Min(const Lhs& lhs, const Rhs& rhs) {
+    return MakeBinaryExpression<BinaryOp::kMin>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs, typename = std::enable_if_t<AreOperands<Lhs, Rhs, false>()>>
+auto Max(const Lhs& lhs, const Rhs& rhs) {
+    return MakeBinaryExpression<BinaryOp::kMax>(lhs, rhs);
+}
+
+template <typename Operand, typename = std::enable_if_t<IsVectorOperand<Operand, false>()>>
+auto Abs(const Operand& operand) {
+    return MakeUnaryExpression<UnaryOp::kAbs>(operand);
+}
+
+template <typename Operand, typename = std::enable_if_t<IsVectorOperand<Operand, false>()>>
+auto Sqrt(const Operand& operand) {
+    return MakeUnaryExpression<UnaryOp::kSqrt>(operand);
+}
+
+//     [low, high]
+template <typename Operand, typename Low, typename High,
+          typename = std::enable_if_t<IsVectorOperand<Operand, false>()>>
+auto Clamp(const Operand& operand, const Low& low, const High& high) {
+    return Min(Max(operand, low), high);
+}
+
+// ----------   ----------
+//   ,   :   SimpleVector
+//    
+
+template <typename Lhs, typename Rhs, typename = std::enable_if_t<AreOperands<Lhs, Rhs, false>()>>
+auto Less(const Lhs& lhs, const Rhs& rhs) {
+    return MakeBinaryExpression<BinaryOp::kLess>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs, typename = std::enable_if_t<AreOperands<Lhs, Rhs, false>()>>
+auto LessEqual(const Lhs& lhs, const Rhs& rhs) {
+    return MakeBinaryExpression<BinaryOp::kLessEqual>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs, typename = std::enable_if_t<AreOperands<Lhs, Rhs, false>()>>
+auto Greater(const Lhs& lhs, const Rhs& rhs) {
+    return MakeBinaryExpression<BinaryOp::kLess>(rhs, lhs);
+}
+
+template <typename Lhs, typename Rhs, typename = std::enable_if_t<AreOperands<Lhs, Rhs, false>()>>
+auto GreaterEqual(const Lhs& lhs, const Rhs& rhs) {
+    return MakeBinaryExpression<BinaryOp::kLessEqual>(rhs, lhs);
+}
+
+template <typename Lhs, typename Rhs, typename = std::enable_if_t<AreOperands<Lhs, Rhs, false>()>>
+auto Equal(const Lhs& lhs, const Rhs& rhs) {
+    return MakeBinaryExpression<BinaryOp::kEqual>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs, typename = std::enable_if_t<AreOperands<Lhs, Rhs, false>()>>
+auto NotEqual(const Lhs& lhs, const Rhs& rhs) {
+    return MakeBinaryExpression<BinaryOp::kNotEqual>(lhs, rhs);
+}
+
+template <typename X>
+struct IsNotExpression : std::false_type {
+};
+
+template <typename Operand>
+struct IsNotExpression<UnaryExpression<UnaryOp::kNot, Operand>> : std::true_type {
+};
+
+// a & ~b  ~a & b    AndNot,    
+template <typename Lhs, typename Rhs, typename = std::enable_if_t<AreOperands<Lhs, Rhs, true>()>>
+auto operator&(const Lhs& lhs, const Rhs& rhs) {
+    if constexpr (IsNotExpression<Rhs>::value) {
+        return MakeBinaryExpression<BinaryOp::kAndNot>(lhs, rhs.GetOperand());
+    }
+    else if constexpr (IsNotExpression<Lhs>::value) {
+        return MakeBinaryExpression<BinaryOp::kAndNot>(rhs, lhs.GetOperand());
+    }
+    else {
+        return MakeBinaryExpression<BinaryOp::kAnd>(lhs, rhs);
+    }
+}
+
+template <typename Lhs, typename Rhs, typename = std::enable_if_t<AreOperands<Lhs, Rhs, true>()>>
+auto operator|(const Lhs& lhs, const Rhs& rhs) {
+    return MakeBinaryExpression<BinaryOp::kOr>(lhs, rhs);
+}
+
+template <typename Operand, typename = std::enable_if_t<IsVectorOperand<Operand, true>()>>
+auto operator~(const Operand& operand) {
+    return MakeUnaryExpression<UnaryOp::kNot>(operand);
+}
+
+//     if_true ,   ,  if_false   
+template <typename Mask, typename IfTrue, typename IfFalse,
+          typename = std::enable_if_t<IsVectorOperand<Mask, true>()>>
+auto Select(const Mask& mask, const IfTrue& if_true, const IfFalse& if_false) {
+    using T = typename Mask::ValueType;
+    static_assert(OperandTraits<IfTrue>::kIsOperand && !OperandTraits<IfTrue>::kIsMask
+        && OperandTraits<IfFalse>::kIsOperand && !OperandTraits<IfFalse>::kIsMask,
+        "Select chooses between values, not masks");
+    auto if_true_operand = MakeOperand<T>(if_true);
+    auto if_false_operand = MakeOperand<T>(if_false);
+    return SelectExpression<Mask, decltype(if_true_operand), decltype(if_false_operand)>(
+        mask, std::move(if_true_operand), std::move(if_false_operand));
+}
+
+// ----------  ----------
+
+//     destination.   destination ,
+//   . destination    
+template <typename T, typename Expression, typename = std::enable_if_t<IsVectorOperand<Expression, false>()>>
+void Assign(SimpleVector<T>& destination, const Expression& expression) {
+    static_assert(std::is_same_v<typename OperandTraits<Expression>::ValueType, T>,
+        "expression and destination element types differ");
+    auto operand = MakeOperand<T>(expression);
+    size_t size = operand.GetSize();
+    destination.Resize(size);
+    const VectorKernels<T>& kernels = GetVectorKernels<T>();
+    //  destination  ,      :
+    //     ,      
+    bool aliased = operand.Aliases(destination.begin());
+    T buffer[kExpressionChunkSize];
+    for (size_t offset = 0; offset < size; offset += kExpressionChunkSize) {
+        size_t count = std::min(kExpressionChunkSize, size - offset);
+        T* out = destination.begin() + offset;
+        const T* result = operand.Evaluate(offset, count, aliased ? buffer : out, kernels);
+        if (result != out) {
+            std::copy(result, result + count, out);
+        }
+    }
+}
+
+//     
+template <typename Expression, typename = std::enable_if_t<IsVectorOperand<Expression, false>()>>
+auto Evaluate(const Expression& expression) {
+    SimpleVector<typename OperandTraits<Expression>::ValueType> result;
+    Assign(result, expression);
+    return result;
+}
+
+// ----------  ----------
+
+template <typename Expression, typename = std::enable_if_t<IsVectorOperand<Expression, false>()>>
+auto Sum(const Expression& expression) {
+    using T = typename OperandTraits<Expression>::ValueType;
+    auto operand = MakeOperand<T>(expression);
+    const VectorKernels<T>& kernels = GetVectorKernels<T>();
+    T buffer[kExpressionChunkSize];
+    T result = 0;
+    for (size_t offset = 0; offset < operand.GetSize(); offset += kExpressionChunkSize) {
+        size_t count = std::min(kExpressionChunkSize, operand.GetSize() - offset);
+        result += kernels.sum(operand.Evaluate(offset, count, buffer, kernels), count);
+    }
+    return result;
+}
+
+//  .         
+template <typename Lhs, typename Rhs, typename = std::enable_if_t<AreOperands<Lhs, Rhs, false>()
+              && !OperandTraits<Lhs>::kIsScalar && !OperandTraits<Rhs>::kIsScalar>>
+auto Dot(const Lhs& lhs, const Rhs& rhs) {
+    using T = CommonValueType<Lhs, Rhs>;
+    auto lhs_operand = MakeOperand<T>(lhs);
+    auto rhs_operand = MakeOperand<T>(rhs);
+    assert(lhs_operand.GetSize() == rhs_operand.GetSize());
+    const VectorKernels<T>& kernels = GetVectorKernels<T>();
+    T lhs_buffer[kExpressionChunkSize];
+    T rhs_buffer[kExpressionChunkSize];
+    T result = 0;
+    for (size_t offset = 0; offset < lhs_operand.GetSize(); offset += kExpressionChunkSize) {
+        size_t count = std::min(kExpressionChunkSize, lhs_operand.GetSize() - offset);
+        result += kernels.dot(lhs_operand.Evaluate(offset, count, lhs_buffer, kernels),
+                              rhs_operand.Evaluate(offset, count, rhs_buffer, kernels), count);
+    }
+    return result;
+}
+
+//    
+template <typename Expression, typename = std::enable_if_t<IsVectorOperand<Expression, false>()>>
+auto MinElement(const Expression& expression) {
+    using T = typename OperandTraits<Expression>::ValueType;
+    auto operand = MakeOperand<T>(expression);
+    assert(operand.GetSize() > 0);
+    const VectorKernels<T>& kernels = GetVectorKernels<T>();
+    T buffer[kExpressionChunkSize];
+    T result = T();
+    for (size_t offset = 0; offset < operand.GetSize(); offset += kExpressionChunkSize) {
+        size_t count = std::min(kExpressionChunkSize, operand.GetSize() - offset);
+        T chunk_result = kernels.min_value(operand.Evaluate(offset, count, buffer, kernels), count);
+        result = offset == 0 ? chunk_result : ScalarOps<T>::Min(result, chunk_result);
+    }
+    return result;
+}
+
+//    
+template <typename Expression, typename = std::enable_if_t<IsVectorOperand<Expression, false>()>>
+auto MaxElement(const Expression& expression) {
+    using T = typename OperandTraits<Expression>::ValueType;
+    auto operand = MakeOperand<T>(expression);
+    assert(operand.GetSize() > 0);
+    const VectorKernels<T>& kernels = GetVectorKernels<T>();
+    T buffer[kExpressionChunkSize];
+    T result = T();
+    for (size_t offset = 0; offset < operand.GetSize(); offset += kExpressionChunkSize) {
+        size_t count = std::min(kExpressionChunkSize, operand.GetSize() - offset);
+        T chunk_result = kernels.max_value(operand.Evaluate(offset, count, buffer, kernels), count);
+        result = offset == 0 ? chunk_result : ScalarOps<T>::Max(result, chunk_result);
+    }
+    return result;
+}
+
+//    
+template <typename Mask, typename = std::enable_if_t<IsVectorOperand<Mask, true>()>>
+size_t Count(const Mask& mask) {
+    using T = typename Mask::ValueType;
+    const VectorKernels<T>& kernels = GetVectorKernels<T>();
+    T buffer[kExpressionChunkSize];
+    size_t result = 0;
+    for (size_t offset = 0; offset < mask.GetSize(); offset += kExpressionChunkSize) {
+        size_t count = std::min(kExpressionChunkSize, mask.GetSize() - offset);
+        result += kernels.count(mask.Evaluate(offset, count, buffer, kernels), count);
+    }
+    return result;
+}
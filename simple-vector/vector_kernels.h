@@ -0,0 +1,529 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+
+#include "bit_operations.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(_M_AMD64)
+#define VECTOR_KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC  Clang         ,
+// MSVC     
+#if defined(__GNUC__) || defined(__clang__)
+#define VECTOR_KERNELS_TARGET(isa) __attribute__((target(isa)))
+#else
+#define VECTOR_KERNELS_TARGET(isa)
+#endif
+
+enum class SimdLevel {
+    kScalar,
+    kSse2,
+    kAvx2,
+    kAvx512,
+};
+
+//    SIMD,      
+inline SimdLevel DetectSimdLevel() noexcept {
+#if defined(VECTOR_KERNELS_X86) && defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {};
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+    __cpuid(info, 1);
+    bool os_saves_ymm = false;
+    bool os_saves_zmm = false;
+    if (info[2] & (1 << 27)) {
+        unsigned long long xcr0 = _xgetbv(0);
+        os_saves_ymm = (xcr0 & 0x06) == 0x06;
+        os_saves_zmm = (xcr0 & 0xe6) == 0xe6;
+    }
+    if (max_leaf >= 7) {
+        __cpuidex(info, 7, 0);
+        if ((info[1] & (1 << 16)) && os_saves_zmm) {
+            return SimdLevel::kAvx512;
+        }
+        if ((info[1] & (1 << 5)) && os_saves_ymm) {
+            return SimdLevel::kAvx2;
+        }
+    }
+    return SimdLevel::kSse2;
+#elif defined(VECTOR_KERNELS_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::kAvx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::kAvx2;
+    }
+    return SimdLevel::kSse2;
+#else
+    return SimdLevel::kScalar;
+#endif
+}
+
+inline SimdLevel& CurrentSimdLevel() noexcept {
+    static SimdLevel level = DetectSimdLevel();
+    return level;
+}
+
+inline SimdLevel GetSimdLevel() noexcept {
+    return CurrentSimdLevel();
+}
+
+//   SIMD,      .
+//      
+inline void SetSimdLevel(SimdLevel level) noexcept {
+    CurrentSimdLevel() = std::min(level, DetectSimdLevel());
+}
+
+enum class BinaryOp {
+    kAdd,
+    kSub,
+    kMul,
+    kDiv,
+    kMin,
+    kMax,
+    kLess,
+    kLessEqual,
+    kEqual,
+    kNotEqual,
+    kAnd,
+    kOr,
+    kAndNot,
+    kCount,
+};
+
+enum class UnaryOp {
+    kNeg,
+    kAbs,
+    kSqrt,
+    kNot,
+    kCount,
+};
+
+//    .        :
+//    - ,   - 
+template <typename T>
+struct ScalarOps {
+    static_assert(std::is_floating_point_v<T>, "vector kernels support float and double");
+
+    using Register = T;
+    using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    static constexpr size_t kWidth = 1;
+
+    static T Load(const T* data) noexcept { return *data; }
+    static void Store(T* data, T value) noexcept { *data = value; }
+    static T Broadcast(T value) noexcept { return value; }
+
+    static T Add(T lhs, T rhs) noexcept { return lhs + rhs; }
+    static T Sub(T lhs, T rhs) noexcept { return lhs - rhs; }
+    static T Mul(T lhs, T rhs) noexcept { return lhs * rhs; }
+    static T Div(T lhs, T rhs) noexcept { return lhs / rhs; }
+    //     minps/maxps:  NaN  rhs
+    static T Min(T lhs, T rhs) noexcept { return lhs < rhs ? lhs : rhs; }
+    static T Max(T lhs, T rhs) noexcept { return lhs > rhs ? lhs : rhs; }
+    static T Sqrt(T value) noexcept { return std::sqrt(value); }
+
+    static T Less(T lhs, T rhs) noexcept { return FromBool(lhs < rhs); }
+    static T LessEqual(T lhs, T rhs) noexcept { return FromBool(lhs <= rhs); }
+    static T Equal(T lhs, T rhs) noexcept { return FromBool(lhs == rhs); }
+    static T NotEqual(T lhs, T rhs) noexcept { return FromBool(lhs != rhs); }
+
+    static T And(T lhs, T rhs) noexcept { return FromBits(ToBits(lhs) & ToBits(rhs)); }
+    static T Or(T lhs, T rhs) noexcept { return FromBits(ToBits(lhs) | ToBits(rhs)); }
+    static T Xor(T lhs, T rhs) noexcept { return FromBits(ToBits(lhs) ^ ToBits(rhs)); }
+    // lhs & ~rhs
+    static T AndNot(T lhs, T rhs) noexcept { return FromBits(ToBits(lhs) & ~ToBits(rhs)); }
+    static T Select(T mask, T if_true, T if_false) noexcept { return ToBits(mask) != 0 ? if_true : if_false; }
+    static size_t CountMask(T mask) noexcept { return ToBits(mask) != 0 ? 1 : 0; }
+
+    static T AllOnes() noexcept { return FromBits(~Bits(0)); }
+
+    static Bits ToBits(T value) noexcept {
+        Bits bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    static T FromBits(Bits bits) noexcept {
+        T value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    static T FromBool(bool value) noexcept {
+        return FromBits(value ? ~Bits(0) : Bits(0));
+    }
+};
+
+#ifdef VECTOR_KERNELS_X86
+
+#define VECTOR_KERNELS_SSE2 VECTOR_KERNELS_TARGET("sse2")
+
+template <typename T>
+struct Sse2Ops;
+
+template <>
+struct Sse2Ops<float> {
+    using Register = __m128;
+    static constexpr size_t kWidth = 4;
+
+    VECTOR_KERNELS_SSE2 static Register Load(const float* data) noexcept { return _mm_loadu_ps(data); }
+    VECTOR_KERNELS_SSE2 static void Store(float* data, Register value) noexcept { _mm_storeu_ps(data, value); }
+    VECTOR_KERNELS_SSE2 static Register Broadcast(float value) noexcept { return _mm_set1_ps(value); }
+
+    VECTOR_KERNELS_SSE2 static Register Add(Register lhs, Register rhs) noexcept { return _mm_add_ps(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register Sub(Register lhs, Register rhs) noexcept { return _mm_sub_ps(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register Mul(Register lhs, Register rhs) noexcept { return _mm_mul_ps(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register Div(Register lhs, Register rhs) noexcept { return _mm_div_ps(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register Min(Register lhs, Register rhs) noexcept { return _mm_min_ps(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register Max(Register lhs, Register rhs) noexcept { return _mm_max_ps(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register Sqrt(Register value) noexcept { return _mm_sqrt_ps(value); }
+
+    VECTOR_KERNELS_SSE2 static Register Less(Register lhs, Register rhs) noexcept { return _mm_cmplt_ps(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register LessEqual(Register lhs, Register rhs) noexcept { return _mm_cmple_ps(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register Equal(Register lhs, Register rhs) noexcept { return _mm_cmpeq_ps(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register NotEqual(Register lhs, Register rhs) noexcept { return _mm_cmpneq_ps(lhs, rhs); }
+
+    VECTOR_KERNELS_SSE2 static Register And(Register lhs, Register rhs) noexcept { return _mm_and_ps(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register Or(Register lhs, Register rhs) noexcept { return _mm_or_ps(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register Xor(Register lhs, Register rhs) noexcept { return _mm_xor_ps(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register AndNot(Register lhs, Register rhs) noexcept { return _mm_andnot_ps(rhs, lhs); }
+    VECTOR_KERNELS_SSE2 static Register Select(Register mask, Register if_true, Register if_false) noexcept {
+        return _mm_or_ps(_mm_and_ps(mask, if_true), _mm_andnot_ps(mask, if_false));
+    }
+    VECTOR_KERNELS_SSE2 static size_t CountMask(Register mask) noexcept {
+        return PopCount(static_cast<uint64_t>(_mm_movemask_ps(mask)));
+    }
+};
+
+template <>
+struct Sse2Ops<double> {
+    using Register = __m128d;
+    static constexpr size_t kWidth = 2;
+
+    VECTOR_KERNELS_SSE2 static Register Load(const double* data) noexcept { return _mm_loadu_pd(data); }
+    VECTOR_KERNELS_SSE2 static void Store(double* data, Register value) noexcept { _mm_storeu_pd(data, value); }
+    VECTOR_KERNELS_SSE2 static Register Broadcast(double value) noexcept { return _mm_set1_pd(value); }
+
+    VECTOR_KERNELS_SSE2 static Register Add(Register lhs, Register rhs) noexcept { return _mm_add_pd(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register Sub(Register lhs, Register rhs) noexcept { return _mm_sub_pd(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register Mul(Register lhs, Register rhs) noexcept { return _mm_mul_pd(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register Div(Register lhs, Register rhs) noexcept { return _mm_div_pd(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register Min(Register lhs, Register rhs) noexcept { return _mm_min_pd(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register Max(Register lhs, Register rhs) noexcept { return _mm_max_pd(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register Sqrt(Register value) noexcept { return _mm_sqrt_pd(value); }
+
+    VECTOR_KERNELS_SSE2 static Register Less(Register lhs, Register rhs) noexcept { return _mm_cmplt_pd(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register LessEqual(Register lhs, Register rhs) noexcept { return _mm_cmple_pd(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register Equal(Register lhs, Register rhs) noexcept { return _mm_cmpeq_pd(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register NotEqual(Register lhs, Register rhs) noexcept { return _mm_cmpneq_pd(lhs, rhs); }
+
+    VECTOR_KERNELS_SSE2 static Register And(Register lhs, Register rhs) noexcept { return _mm_and_pd(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register Or(Register lhs, Register rhs) noexcept { return _mm_or_pd(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register Xor(Register lhs, Register rhs) noexcept { return _mm_xor_pd(lhs, rhs); }
+    VECTOR_KERNELS_SSE2 static Register AndNot(Register lhs, Register rhs) noexcept { return _mm_andnot_pd(rhs, lhs); }
+    VECTOR_KERNELS_SSE2 static Register Select(Register mask, Register if_true, Register if_false) noexcept {
+        return _mm_or_pd(_mm_and_pd(mask, if_true), _mm_andnot_pd(mask, if_false));
+    }
+    VECTOR_KERNELS_SSE2 static size_t CountMask(Register mask) noexcept {
+        return PopCount(static_cast<uint64_t>(_mm_movemask_pd(mask)));
+    }
+};
+
+#define VECTOR_KERNELS_AVX2 VECTOR_KERNELS_TARGET("avx2")
+
+template <typename T>
+struct Avx2Ops;
+
+template <>
+struct Avx2Ops<float> {
+    using Register = __m256;
+    static constexpr size_t kWidth = 8;
+
+    VECTOR_KERNELS_AVX2 static Register Load(const float* data) noexcept { return _mm256_loadu_ps(data); }
+    VECTOR_KERNELS_AVX2 static void Store(float* data, Register value) noexcept { _mm256_storeu_ps(data, value); }
+    VECTOR_KERNELS_AVX2 static Register Broadcast(float value) noexcept { return _mm256_set1_ps(value); }
+
+    VECTOR_KERNELS_AVX2 static Register Add(Register lhs, Register rhs) noexcept { return _mm256_add_ps(lhs, rhs); }
+    VECTOR_KERNELS_AVX2 static Register Sub(Register lhs, Register rhs) noexcept { return _mm256_sub_ps(lhs, rhs); }
+    VECTOR_KERNELS_AVX2 static Register Mul(Register lhs, Register rhs) noexcept { return _mm256_mul_ps(lhs, rhs); }
+    VECTOR_KERNELS_AVX2 static Register Div(Register lhs, Register rhs) noexcept { return _mm256_div_ps(lhs, rhs); }
+    VECTOR_KERNELS_AVX2 static Register Min(Register lhs, Register rhs) noexcept { return _mm256_min_ps(lhs, rhs); }
+    VECTOR_KERNELS_AVX2 static Register Max(Register lhs, Register rhs) noexcept { return _mm256_max_ps(lhs, rhs); }
+    VECTOR_KERNELS_AVX2 static Register Sqrt(Register value) noexcept { return _mm256_sqrt_ps(value); }
+
+    VECTOR_KERNELS_AVX2 static Register Less(Register lhs, Register rhs) noexcept {
+        return _mm256_cmp_ps(lhs, rhs, _CMP_LT_OQ);
+    }
+    VECTOR_KERNELS_AVX2 static Register LessEqual(Register lhs, Register rhs) noexcept {
+        return _mm256_cmp_ps(lhs, rhs, _CMP_LE_OQ);
+    }
+    VECTOR_KERNELS_AVX2 static Register Equal(Register lhs, Register rhs) noexcept {
+        return _mm256_cmp_ps(lhs, rhs, _CMP_EQ_OQ);
+    }
+    VECTOR_KERNELS_AVX2 static Register NotEqual(Register lhs, Register rhs) noexcept {
+        return _mm256_cmp_ps(lhs, rhs, _CMP_NEQ_UQ);
+    }
+
+    VECTOR_KERNELS_AVX2 static Register And(Register lhs, Register rhs) noexcept { return _mm256_and_ps(lhs, rhs); }
+    VECTOR_KERNELS_AVX2 static Register Or(Register lhs, Register rhs) noexcept { return _mm256_or_ps(lhs, rhs); }
+    VECTOR_KERNELS_AVX2 static Register Xor(Register lhs, Register rhs) noexcept { return _mm256_xor_ps(lhs, rhs); }
+    VECTOR_KERNELS_AVX2 static Register AndNot(Register lhs, Register rhs) noexcept { return _mm256_andnot_ps(rhs, lhs); }
+    VECTOR_KERNELS_AVX2 static Register Select(Register mask, Register if_true, Register if_false) noexcept {
+        return _mm256_blendv_ps(if_false, if_true, mask);
+    }
+    VECTOR_KERNELS_AVX2 static size_t CountMask(Register mask) noexcept {
+        return PopCount(static_cast<uint64_t>(_mm256_movemask_ps(mask)));
+    }
+};
+
+template <>
+struct Avx2Ops<double> {
+    using Register = __m256d;
+    static constexpr size_t kWidth = 4;
+
+    VECTOR_KERNELS_AVX2 static Register Load(const double* data) noexcept { return _mm256_loadu_pd(data); }
+    VECTOR_KERNELS_AVX2 static void Store(double* data, Register value) noexcept { _mm256_storeu_pd(data, value); }
+    VECTOR_KERNELS_AVX2 static Register Broadcast(double value) noexcept { return _mm256_set1_pd(value); }
+
+    VECTOR_KERNELS_AVX2 static Register Add(Register lhs, Register rhs) noexcept { return _mm256_add_pd(lhs, rhs); }
+    VECTOR_KERNELS_AVX2 static Register Sub(Register lhs, Register rhs) noexcept { return _mm256_sub_pd(lhs, rhs); }
+    VECTOR_KERNELS_AVX2 static Register Mul(Register lhs, Register rhs) noexcept { return _mm256_mul_pd(lhs, rhs); }
+    VECTOR_KERNELS_AVX2 static Register Div(Register lhs, Register rhs) noexcept { return _mm256_div_pd(lhs, rhs); }
+    VECTOR_KERNELS_AVX2 static Register Min(Register lhs, Register rhs) noexcept { return _mm256_min_pd(lhs, rhs); }
+    VECTOR_KERNELS_AVX2 static Register Max(Register lhs, Register rhs) noexcept { return _mm256_max_pd(lhs, rhs); }
+    VECTOR_KERNELS_AVX2 static Register Sqrt(Register value) noexcept { return _mm256_sqrt_pd(value); }
+
+    VECTOR_KERNELS_AVX2 static Register Less(Register lhs, Register rhs) noexcept {
+        return _mm256_cmp_pd(lhs, rhs, _CMP_LT_OQ);
+    }
+    VECTOR_KERNELS_AVX2 static Register LessEqual(Register lhs, Register rhs) noexcept {
+        return _mm256_cmp_pd(lhs, rhs, _CMP_LE_OQ);
+    }
+    VECTOR_KERNELS_AVX2 static Register Equal(Register lhs, Register rhs) noexcept {
+        return _mm256_cmp_pd(lhs, rhs, _CMP_EQ_OQ);
+    }
+    VECTOR_KERNELS_AVX2 static Register NotEqual(Register lhs, Register rhs) noexcept {
+        return _mm256_cmp_pd(lhs, rhs, _CMP_NEQ_UQ);
+    }
+
+    VECTOR_KERNELS_AVX2 static Register And(Register lhs, Register rhs) noexcept { return _mm256_and_pd(lhs, rhs); }
+    VECTOR_KERNELS_AVX2 static Register Or(Register lhs, Register rhs) noexcept { return _mm256_or_pd(lhs, rhs); }
+    VECTOR_KERNELS_AVX2 static Register Xor(Register lhs, Register rhs) noexcept { return _mm256_xor_pd(lhs, rhs); }
+    VECTOR_KERNELS_AVX2 static Register AndNot(Register lhs, Register rhs) noexcept { return _mm256_andnot_pd(rhs, lhs); }
+    VECTOR_KERNELS_AVX2 static Register Select(Register mask, Register if_true, Register if_false) noexcept {
+        return _mm256_blendv_pd(if_false, if_true, mask);
+    }
+    VECTOR_KERNELS_AVX2 static size_t CountMask(Register mask) noexcept {
+        return PopCount(static_cast<uint64_t>(_mm256_movemask_pd(mask)));
+    }
+};
+
+//  AVX-512F   - k.      
+//  ,         .  
+//  float  double    AVX-512DQ,      
+#define VECTOR_KERNELS_AVX512 VECTOR_KERNELS_TARGET("avx512f")
+
+// GCC 12        
+// avx512fintrin.h,     _mm512_undefined_*. 
+//     AVX-512
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+template <typename T>
+struct Avx512Ops;
+
+template <>
+struct Avx512Ops<float> {
+    using Register = __m512;
+    static constexpr size_t kWidth = 16;
+
+    VECTOR_KERNELS_AVX512 static Register Load(const float* data) noexcept { return _mm512_loadu_ps(data); }
+    VECTOR_KERNELS_AVX512 static void Store(float* data, Register value) noexcept { _mm512_storeu_ps(data, value); }
+    VECTOR_KERNELS_AVX512 static Register Broadcast(float value) noexcept { return _mm512_set1_ps(value); }
+
+    VECTOR_KERNELS_AVX512 static Register Add(Register lhs, Register rhs) noexcept { return _mm512_add_ps(lhs, rhs); }
+    VECTOR_KERNELS_AVX512 static Register Sub(Register lhs, Register rhs) noexcept { return _mm512_sub_ps(lhs, rhs); }
+    VECTOR_KERNELS_AVX512 static Register Mul(Register lhs, Register rhs) noexcept { return _mm512_mul_ps(lhs, rhs); }
+    VECTOR_KERNELS_AVX512 static Register Div(Register lhs, Register rhs) noexcept { return _mm512_div_ps(lhs, rhs); }
+    VECTOR_KERNELS_AVX512 static Register Min(Register lhs, Register rhs) noexcept { return _mm512_min_ps(lhs, rhs); }
+    VECTOR_KERNELS_AVX512 static Register Max(Register lhs, Register rhs) noexcept { return _mm512_max_ps(lhs, rhs); }
+    VECTOR_KERNELS_AVX512 static Register Sqrt(Register value) noexcept { return _mm512_sqrt_ps(value); }
+
+    VECTOR_KERNELS_AVX512 static Register Less(Register lhs, Register rhs) noexcept {
+        return FromMask(_mm512_cmp_ps_mask(lhs, rhs, _CMP_LT_OQ));
+    }
+    VECTOR_KERNELS_AVX512 static Register LessEqual(Register lhs, Register rhs) noexcept {
+        return FromMask(_mm512_cmp_ps_mask(lhs, rhs, _CMP_LE_OQ));
+    }
+    VECTOR_KERNELS_AVX512 static Register Equal(Register lhs, Register rhs) noexcept {
+        return FromMask(_mm512_cmp_ps_mask(lhs, rhs, _CMP_EQ_OQ));
+    }
+    VECTOR_KERNELS_AVX512 static Register NotEqual(Register lhs, Register rhs) noexcept {
+        return FromMask(_mm512_cmp_ps_mask(lhs, rhs, _CMP_NEQ_UQ));
+    }
+
+    VECTOR_KERNELS_AVX512 static Register And(Register lhs, Register rhs) noexcept {
+        return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(lhs), _mm512_castps_si512(rhs)));
+    }
+    VECTOR_KERNELS_AVX512 static Register Or(Register lhs, Register rhs) noexcept {
+        return _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(lhs), _mm512_castps_si512(rhs)));
+    }
+    VECTOR_KERNELS_AVX512 static Register Xor(Register lhs, Register rhs) noexcept {
+        return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(lhs), _mm512_castps_si512(rhs)));
+    }
+    VECTOR_KERNELS_AVX512 static Register AndNot(Register lhs, Register rhs) noexcept {
+        return _mm512_castsi512_ps(_mm512_andnot_si512(_mm512_castps_si512(rhs), _mm512_castps_si512(lhs)));
+    }
+    VECTOR_KERNELS_AVX512 static Register Select(Register mask, Register if_true, Register if_false) noexcept {
+        return _mm512_mask_blend_ps(ToMask(mask), if_false, if_true);
+    }
+    VECTOR_KERNELS_AVX512 static size_t CountMask(Register mask) noexcept {
+        return PopCount(static_cast<uint64_t>(ToMask(mask)));
+    }
+
+    VECTOR_KERNELS_AVX512 static Register FromMask(__mmask16 mask) noexcept {
+        return _mm512_castsi512_ps(_mm512_maskz_set1_epi32(mask, -1));
+    }
+    VECTOR_KERNELS_AVX512 static __mmask16 ToMask(Register mask) noexcept {
+        __m512i bits = _mm512_castps_si512(mask);
+        return _mm512_test_epi32_mask(bits, bits);
+    }
+};
+
+template <>
+struct Avx512Ops<double> {
+    using Register = __m512d;
+    static constexpr size_t kWidth = 8;
+
+    VECTOR_KERNELS_AVX512 static Register Load(const double* data) noexcept { return _mm512_loadu_pd(data); }
+    VECTOR_KERNELS_AVX512 static void Store(double* data, Register value) noexcept { _mm512_storeu_pd(data, value); }
+    VECTOR_KERNELS_AVX512 static Register Broadcast(double value) noexcept { return _mm512_set1_pd(value); }
+
+    VECTOR_KERNELS_AVX512 static Register Add(Register lhs, Register rhs) noexcept { return _mm512_add_pd(lhs, rhs); }
+    VECTOR_KERNELS_AVX512 static Register Sub(Register lhs, Register rhs) noexcept { return _mm512_sub_pd(lhs, rhs); }
+    VECTOR_KERNELS_AVX512 static Register Mul(Register lhs, Register rhs) noexcept { return _mm512_mul_pd(lhs, rhs); }
+    VECTOR_KERNELS_AVX512 static Register Div(Register lhs, Register rhs) noexcept { return _mm512_div_pd(lhs, rhs); }
+    VECTOR_KERNELS_AVX512 static Register Min(Register lhs, Register rhs) noexcept { return _mm512_min_pd(lhs, rhs); }
+    VECTOR_KERNELS_AVX512 static Register Max(Register lhs, Register rhs) noexcept { return _mm512_max_pd(lhs, rhs); }
+    VECTOR_KERNELS_AVX512 static Register Sqrt(Register value) noexcept { return _mm512_sqrt_pd(value); }
+
+    VECTOR_KERNELS_AVX512 static Register Less(Register lhs, Register rhs) noexcept {
+        return FromMask(_mm512_cmp_pd_mask(lhs, rhs, _CMP_LT_OQ));
+    }
+    VECTOR_KERNELS_AVX512 static Register LessEqual(Register lhs, Register rhs) noexcept {
+        return FromMask(_mm512_cmp_pd_mask(lhs, rhs, _CMP_LE_OQ));
+    }
+    VECTOR_KERNELS_AVX512 static Register Equal(Register lhs, Register rhs) noexcept {
+        return FromMask(_mm512_cmp_pd_mask(lhs, rhs, _CMP_EQ_OQ));
+    }
+    VECTOR_KERNELS_AVX512 static Register NotEqual(Register lhs, Register rhs) noexcept {
+        return FromMask(_mm512_cmp_pd_mask(lhs, rhs, _CMP_NEQ_UQ));
+    }
+
+    VECTOR_KERNELS_AVX512 static Register And(Register lhs, Register rhs) noexcept {
+        return _mm512_castsi512_pd(_mm512_and_si512(_mm512_castpd_si512(lhs), _mm512_castpd_si512(rhs)));
+    }
+    VECTOR_KERNELS_AVX512 static Register Or(Register lhs, Register rhs) noexcept {
+        return _mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(lhs), _mm512_castpd_si512(rhs)));
+    }
+    VECTOR_KERNELS_AVX512 static Register Xor(Register lhs, Register rhs) noexcept {
+        return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(lhs), _mm512_castpd_si512(rhs)));
+    }
+    VECTOR_KERNELS_AVX512 static Register AndNot(Register lhs, Register rhs) noexcept {
+        return _mm512_castsi512_pd(_mm512_andnot_si512(_mm512_castpd_si512(rhs), _mm512_castpd_si512(lhs)));
+    }
+    VECTOR_KERNELS_AVX512 static Register Select(Register mask, Register if_true, Register if_false) noexcept {
+        return _mm512_mask_blend_pd(ToMask(mask), if_false, if_true);
+    }
+    VECTOR_KERNELS_AVX512 static size_t CountMask(Register mask) noexcept {
+        return PopCount(static_cast<uint64_t>(ToMask(mask)));
+    }
+
+    VECTOR_KERNELS_AVX512 static Register FromMask(__mmask8 mask) noexcept {
+        return _mm512_castsi512_pd(_mm512_maskz_set1_epi64(mask, -1));
+    }
+    VECTOR_KERNELS_AVX512 static __mmask8 ToMask(Register mask) noexcept {
+        __m512i bits = _mm512_castpd_si512(mask);
+        return _mm512_test_epi64_mask(bits, bits);
+    }
+};
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif  // VECTOR_KERNELS_X86
+
+//     SIMD.      ,
+//             AVX
+template <typename T>
+struct VectorKernels {
+    void (*binary[static_cast<size_t>(BinaryOp::kCount)])(const T* lhs, const T* rhs, T* out, size_t size);
+    //    :        
+    void (*binary_scalar[static_cast<size_t>(BinaryOp::kCount)])(const T* lhs, T rhs, T* out, size_t size);
+    void (*scalar_binary[static_cast<size_t>(BinaryOp::kCount)])(T lhs, const T* rhs, T* out, size_t size);
+    void (*unary[static_cast<size_t>(UnaryOp::kCount)])(const T* operand, T* out, size_t size);
+    void (*select)(const T* mask, const T* if_true, const T* if_false, T* out, size_t size);
+    T (*sum)(const T* data, size_t size);
+    T (*dot)(const T* lhs, const T* rhs, size_t size);
+    T (*min_value)(const T* data, size_t size);
+    T (*max_value)(const T* data, size_t size);
+    size_t (*count)(const T* mask, size_t size);
+    void (*fill)(T value, T* out, size_t size);
+};
+
+//           SIMD  
+// VECTOR_KERNELS_NAME, VECTOR_KERNELS_OPS  VECTOR_KERNELS_ATTRIBUTE
+
+#define VECTOR_KERNELS_NAME ScalarKernels
+#define VECTOR_KERNELS_OPS ScalarOps
+#define VECTOR_KERNELS_ATTRIBUTE
+#include "vector_kernels.inl"
+
+#ifdef VECTOR_KERNELS_X86
+
+#define VECTOR_KERNELS_NAME Sse2Kernels
+#define VECTOR_KERNELS_OPS Sse2Ops
+#define VECTOR_KERNELS_ATTRIBUTE VECTOR_KERNELS_SSE2
+#include "vector_kernels.inl"
+
+#define VECTOR_KERNELS_NAME Avx2Kernels
+#define VECTOR_KERNELS_OPS Avx2Ops
+#define VECTOR_KERNELS_ATTRIBUTE VECTOR_KERNELS_AVX2
+#include "vector_kernels.inl"
+
+#define VECTOR_KERNELS_NAME Avx512Kernels
+#define VECTOR_KERNELS_OPS Avx512Ops
+#define VECTOR_KERNELS_ATTRIBUTE VECTOR_KERNELS_AVX512
+#include "vector_kernels.inl"
+
+#endif  // VECTOR_KERNELS_X86
+
+//       SIMD
+template <typename T>
+const VectorKernels<T>& GetVectorKernels() noexcept {
+#ifdef VECTOR_KERNELS_X86
+    static const VectorKernels<T> tables[] = {
+        ScalarKernels<T>::MakeTable(),
+        Sse2Kernels<T>::MakeTable(),
+        Avx2Kernels<T>::MakeTable(),
+        Avx512Kernels<T>::MakeTable(),
+    };
+    return tables[static_cast<size_t>(GetSimdLevel())];
+#else
+    static const VectorKernels<T> table = ScalarKernels<T>::MakeTable();
+    return table;
+#endif
+}
@@ -0,0 +1,251 @@
+//      SIMD.       :
+// vector_kernels.h     ,   
+// VECTOR_KERNELS_NAME -    ,
+// VECTOR_KERNELS_OPS -    ,
+// VECTOR_KERNELS_ATTRIBUTE -      
+
+template <typename T>
+struct VECTOR_KERNELS_NAME {
+    using Ops = VECTOR_KERNELS_OPS<T>;
+    using Scalar = ScalarOps<T>;
+    using Register = typename Ops::Register;
+
+    template <BinaryOp Op, typename O>
+    VECTOR_KERNELS_ATTRIBUTE static typename O::Register ApplyBinary(
+            typename O::Register lhs, typename O::Register rhs) noexcept {
+        if constexpr (Op == BinaryOp::kAdd) {
+            return O::Add(lhs, rhs);
+        }
+        else if constexpr (Op == BinaryOp::kSub) {
+            return O::Sub(lhs, rhs);
+        }
+        else if constexpr (Op == BinaryOp::kMul) {
+            return O::Mul(lhs, rhs);
+        }
+        else if constexpr (Op == BinaryOp::kDiv) {
+            return O::Div(lhs, rhs);
+        }
+        else if constexpr (Op == BinaryOp::kMin) {
+            return O::Min(lhs, rhs);
+        }
+        else if constexpr (Op == BinaryOp::kMax) {
+            return O::Max(lhs, rhs);
+        }
+        else if constexpr (Op == BinaryOp::kLess) {
+            return O::Less(lhs, rhs);
+        }
+        else if constexpr (Op == BinaryOp::kLessEqual) {
+            return O::LessEqual(lhs, rhs);
+        }
+        else if constexpr (Op == BinaryOp::kEqual) {
+            return O::Equal(lhs, rhs);
+        }
+        else if constexpr (Op == BinaryOp::kNotEqual) {
+            return O::NotEqual(lhs, rhs);
+        }
+        else if constexpr (Op == BinaryOp::kAnd) {
+            return O::And(lhs, rhs);
+        }
+        else if constexpr (Op == BinaryOp::kOr) {
+            return O::Or(lhs, rhs);
+        }
+        else {
+            static_assert(Op == BinaryOp::kAndNot, "unknown binary operation");
+            return O::AndNot(lhs, rhs);
+        }
+    }
+
+    template <UnaryOp Op, typename O>
+    VECTOR_KERNELS_ATTRIBUTE static typename O::Register ApplyUnary(typename O::Register operand) noexcept {
+        if constexpr (Op == UnaryOp::kNeg) {
+            return O::Xor(operand, O::Broadcast(T(-0.0)));
+        }
+        else if constexpr (Op == UnaryOp::kAbs) {
+            return O::AndNot(operand, O::Broadcast(T(-0.0)));
+        }
+        else if constexpr (Op == UnaryOp::kSqrt) {
+            return O::Sqrt(operand);
+        }
+        else {
+            static_assert(Op == UnaryOp::kNot, "unknown unary operation");
+            return O::Xor(operand, O::Broadcast(Scalar::AllOnes()));
+        }
+    }
+
+    // out    lhs  rhs:        
+    template <BinaryOp Op>
+    VECTOR_KERNELS_ATTRIBUTE static void Binary(const T* lhs, const T* rhs, T* out, size_t size) noexcept {
+        size_t i = 0;
+        for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+            Ops::Store(out + i, ApplyBinary<Op, Ops>(Ops::Load(lhs + i), Ops::Load(rhs + i)));
+        }
+        for (; i < size; ++i) {
+            out[i] = ApplyBinary<Op, Scalar>(lhs[i], rhs[i]);
+        }
+    }
+
+    template <BinaryOp Op>
+    VECTOR_KERNELS_ATTRIBUTE static void BinaryScalar(const T* lhs, T rhs, T* out, size_t size) noexcept {
+        Register rhs_register = Ops::Broadcast(rhs);
+        size_t i = 0;
+        for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+            Ops::Store(out + i, ApplyBinary<Op, Ops>(Ops::Load(lhs + i), rhs_register));
+        }
+        for (; i < size; ++i) {
+            out[i] = ApplyBinary<Op, Scalar>(lhs[i], rhs);
+        }
+    }
+
+    template <BinaryOp Op>
+    VECTOR_KERNELS_ATTRIBUTE static void ScalarBinary(T lhs, const T* rhs, T* out, size_t size) noexcept {
+        Register lhs_register = Ops::Broadcast(lhs);
+        size_t i = 0;
+        for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+            Ops::Store(out + i, ApplyBinary<Op, Ops>(lhs_register, Ops::Load(rhs + i)));
+        }
+        for (; i < size; ++i) {
+            out[i] = ApplyBinary<Op, Scalar>(lhs, rhs[i]);
+        }
+    }
+
+    VECTOR_KERNELS_ATTRIBUTE static void Fill(T value, T* out, size_t size) noexcept {
+        Register broadcast = Ops::Broadcast(value);
+        size_t i = 0;
+        for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+            Ops::Store(out + i, broadcast);
+        }
+        for (; i < size; ++i) {
+            out[i] = value;
+        }
+    }
+
+    template <UnaryOp Op>
+    VECTOR_KERNELS_ATTRIBUTE static void Unary(const T* operand, T* out, size_t size) noexcept {
+        size_t i = 0;
+        for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+            Ops::Store(out + i, ApplyUnary<Op, Ops>(Ops::Load(operand + i)));
+        }
+        for (; i < size; ++i) {
+            out[i] = ApplyUnary<Op, Scalar>(operand[i]);
+        }
+    }
+
+    VECTOR_KERNELS_ATTRIBUTE static void Select(const T* mask, const T* if_true, const T* if_false,
+                                                T* out, size_t size) noexcept {
+        size_t i = 0;
+        for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+            Ops::Store(out + i, Ops::Select(Ops::Load(mask + i), Ops::Load(if_true + i), Ops::Load(if_false + i)));
+        }
+        for (; i < size; ++i) {
+            out[i] = Scalar::Select(mask[i], if_true[i], if_false[i]);
+        }
+    }
+
+    //    ,      
+    VECTOR_KERNELS_ATTRIBUTE static T Sum(const T* data, size_t size) noexcept {
+        Register accumulator = Ops::Broadcast(T(0));
+        size_t i = 0;
+        for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+            accumulator = Ops::Add(accumulator, Ops::Load(data + i));
+        }
+        T result = ReduceLanes<BinaryOp::kAdd>(accumulator);
+        for (; i < size; ++i) {
+            result += data[i];
+        }
+        return result;
+    }
+
+    VECTOR_KERNELS_ATTRIBUTE static T Dot(const T* lhs, const T* rhs, size_t size) noexcept {
+        Register accumulator = Ops::Broadcast(T(0));
+        size_t i = 0;
+        for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+            accumulator = Ops::Add(accumulator, Ops::Mul(Ops::Load(lhs + i), Ops::Load(rhs + i)));
+        }
+        T result = ReduceLanes<BinaryOp::kAdd>(accumulator);
+        for (; i < size; ++i) {
+            result += lhs[i] * rhs[i];
+        }
+        return result;
+    }
+
+    // size    
+    template <BinaryOp Op>
+    VECTOR_KERNELS_ATTRIBUTE static T Extremum(const T* data, size_t size) noexcept {
+        T result = data[0];
+        size_t i = 0;
+        if (size >= Ops::kWidth) {
+            Register accumulator = Ops::Load(data);
+            for (i = Ops::kWidth; i + Ops::kWidth <= size; i += Ops::kWidth) {
+                accumulator = ApplyBinary<Op, Ops>(accumulator, Ops::Load(data + i));
+            }
+            result = ReduceLanes<Op>(accumulator);
+        }
+        for (; i < size; ++i) {
+            result = ApplyBinary<Op, Scalar>(result, data[i]);
+        }
+        return result;
+    }
+
+    VECTOR_KERNELS_ATTRIBUTE static size_t Count(const T* mask, size_t size) noexcept {
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+            count += Ops::CountMask(Ops::Load(mask + i));
+        }
+        for (; i < size; ++i) {
+            count += Scalar::CountMask(mask[i]);
+        }
+        return count;
+    }
+
+    template <BinaryOp Op>
+    VECTOR_KERNELS_ATTRIBUTE static T ReduceLanes(Register value) noexcept {
+        T lanes[Ops::kWidth];
+        Ops::Store(lanes, value);
+        T result = lanes[0];
+        for (size_t i = 1; i < Ops::kWidth; ++i) {
+            result = ApplyBinary<Op, Scalar>(result, lanes[i]);
+        }
+        return result;
+    }
+
+    template <BinaryOp Op>
+    static void SetBinary(VectorKernels<T>& table) noexcept {
+        table.binary[static_cast<size_t>(Op)] = &Binary<Op>;
+        table.binary_scalar[static_cast<size_t>(Op)] = &BinaryScalar<Op>;
+        table.scalar_binary[static_cast<size_t>(Op)] = &ScalarBinary<Op>;
+    }
+
+    static VectorKernels<T> MakeTable() noexcept {
+        VectorKernels<T> table{};
+        SetBinary<BinaryOp::kAdd>(table);
+        SetBinary<BinaryOp::kSub>(table);
+        SetBinary<BinaryOp::kMul>(table);
+        SetBinary<BinaryOp::kDiv>(table);
+        SetBinary<BinaryOp::kMin>(table);
+        SetBinary<BinaryOp::kMax>(table);
+        SetBinary<BinaryOp::kLess>(table);
+        SetBinary<BinaryOp::kLessEqual>(table);
+        SetBinary<BinaryOp::kEqual>(table);
+        SetBinary<BinaryOp::kNotEqual>(table);
+        SetBinary<BinaryOp::kAnd>(table);
+        SetBinary<BinaryOp::kOr>(table);
+        SetBinary<BinaryOp::kAndNot>(table);
+        table.unary[static_cast<size_t>(UnaryOp::kNeg)] = &Unary<UnaryOp::kNeg>;
+        table.unary[static_cast<size_t>(UnaryOp::kAbs)] = &Unary<UnaryOp::kAbs>;
+        table.unary[static_cast<size_t>(UnaryOp::kSqrt)] = &Unary<UnaryOp::kSqrt>;
+        table.unary[static_cast<size_t>(UnaryOp::kNot)] = &Unary<UnaryOp::kNot>;
+        table.select = &Select;
+        table.sum = &Sum;
+        table.dot = &Dot;
+        table.min_value = &Extremum<BinaryOp::kMin>;
+        table.max_value = &Extremum<BinaryOp::kMax>;
+        table.count = &Count;
+        table.fill = &Fill;
+        return table;
+    }
+};
+
+#undef VECTOR_KERNELS_NAME
+#undef VECTOR_KERNELS_OPS
+#undef VECTOR_KERNELS_ATTRIBUTE